@@ -0,0 +1,187 @@
+#include "Arena.h"
+
+#include <cstdint>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Given:  Nothing.
+//
+// Task:   To initialize an arena that has not reserved any memory yet.
+//
+// Return: Nothing.
+Arena::Arena(void) {
+    current = 0;
+}
+
+// Given:  Nothing.
+//
+// Task:   To return every block to the system. Pointers handed out by the arena are invalid afterwards.
+//
+// Return: Nothing.
+Arena::~Arena(void) {
+    for (Block& block : blocks) {
+#ifdef _WIN32
+        VirtualFree(block.base, 0, MEM_RELEASE);
+#else
+        munmap(block.base, block.size);
+#endif
+    }
+}
+
+// Given:  bytes    - The smallest block that will do.
+//
+// Task:   To reserve a new block of at least ARENA_BLOCK_BYTES, rounded to whole huge pages and aligned to one, asking
+//         for explicit huge pages first when ARENA_HUGE_PAGES is 2 and transparent ones when it is 1 or 2.
+//
+// Return: true or false        - True indicating a block was added, False indicating the system is out of memory.
+bool Arena::Reserve(const size_t bytes) {
+    size_t size = (bytes > ARENA_BLOCK_BYTES) ? bytes : ARENA_BLOCK_BYTES;
+    size = (size + ARENA_HUGE_PAGE_BYTES - 1) / ARENA_HUGE_PAGE_BYTES * ARENA_HUGE_PAGE_BYTES;
+    char* base = nullptr;
+
+#ifdef _WIN32
+    if (ARENA_HUGE_PAGES == 2 && GetLargePageMinimum() != 0) {
+        // Needs the lock pages privilege; without it the call fails and normal pages are used.
+        base = static_cast<char*>(VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE));
+    }
+    if (base == nullptr) {
+        base = static_cast<char*>(VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+    }
+    if (base == nullptr) {
+        return false;
+    }
+#else
+#ifdef MAP_HUGETLB
+    if (ARENA_HUGE_PAGES == 2) {
+        void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        base = (mapping == MAP_FAILED) ? nullptr : static_cast<char*>(mapping); // Fails when no huge pages are reserved.
+    }
+#endif
+    if (base == nullptr) {
+        // Map a huge page more than needed and trim both ends, so the block starts on a huge page boundary.
+        void* mapping = mmap(nullptr, size + ARENA_HUGE_PAGE_BYTES, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapping == MAP_FAILED) {
+            return false;
+        }
+        char* start = static_cast<char*>(mapping);
+        base = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(start) + ARENA_HUGE_PAGE_BYTES - 1) / ARENA_HUGE_PAGE_BYTES * ARENA_HUGE_PAGE_BYTES);
+        if (base > start) {
+            munmap(start, base - start);
+        }
+        const size_t tail = (start + size + ARENA_HUGE_PAGE_BYTES) - (base + size);
+        if (tail > 0) {
+            munmap(base + size, tail);
+        }
+#ifdef MADV_HUGEPAGE
+        if (ARENA_HUGE_PAGES >= 1) {
+            madvise(base, size, MADV_HUGEPAGE);
+        }
+#endif
+    }
+#endif
+
+    blocks.push_back({ base, size, 0, 0 });
+    return true;
+}
+
+// Given:  bytes    - The number of bytes wanted.
+//         zeroed   - Whether every byte must be zero.
+//
+// Task:   To hand out the next ARENA_ALIGNMENT aligned run of bytes, moving on to a later block, or reserving a new
+//         one, when the current block is full.
+//
+// Return: A pointer to the first byte. Throws std::bad_alloc when the system is out of memory.
+void* Arena::AllocateBytes(const size_t bytes, const bool zeroed) {
+    size_t start = 0;
+    if (!blocks.empty()) {
+        start = (blocks[current].used + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT;
+    }
+    if (blocks.empty() || start + bytes > blocks[current].size) {
+        // Blocks after the current one are empty, either never used or freed by a Rewind.
+        size_t next = blocks.empty() ? 0 : current + 1;
+        while (next < blocks.size() && blocks[next].size < bytes) {
+            next++;
+        }
+        if (next == blocks.size() && !Reserve(bytes)) {
+            throw std::bad_alloc();
+        }
+        current = next;
+        start = 0;
+    }
+
+    Block& block = blocks[current];
+    const size_t end = start + bytes;
+    if (zeroed && start < block.touched) {
+        std::memset(block.base + start, 0, ((end < block.touched) ? end : block.touched) - start);
+    }
+    block.used = end;
+    if (end > block.touched) {
+        block.touched = end;
+    }
+    return block.base + start;
+}
+
+// Given:  Nothing.
+//
+// Task:   To record how much of the arena is in use.
+//
+// Return: A mark which Rewind can return the arena to.
+ArenaMark Arena::Mark(void) {
+    return { current, blocks.empty() ? 0 : blocks[current].used };
+}
+
+// Given:  mark     - A mark taken earlier by Mark.
+//
+// Task:   To free everything allocated since the mark was taken, keeping the blocks for the allocations to come.
+//
+// Return: Nothing.
+void Arena::Rewind(const ArenaMark& mark) {
+    if (blocks.empty()) {
+        return;
+    }
+    for (size_t b = mark.block + 1; b < blocks.size(); b++) {
+        blocks[b].used = 0;
+    }
+    current = mark.block;
+    blocks[current].used = mark.used;
+}
+
+// Given:  pointer  - Memory handed out by the arena that is no longer needed.
+//         bytes    - The length of the memory.
+//
+// Task:   To give the whole pages inside the memory back to the system while the allocations around it live on. The
+//         address range stays reserved, and reads as zero if touched again.
+//
+// Return: Nothing.
+void Arena::Release(void* pointer, const size_t bytes) {
+#ifndef _WIN32
+    const uintptr_t pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    const uintptr_t first = (reinterpret_cast<uintptr_t>(pointer) + pageSize - 1) / pageSize * pageSize;
+    const uintptr_t last = (reinterpret_cast<uintptr_t>(pointer) + bytes) / pageSize * pageSize;
+    if (first < last) {
+        madvise(reinterpret_cast<void*>(first), last - first, MADV_DONTNEED);
+    }
+#else
+    (void)pointer;
+    (void)bytes;
+#endif
+}
+
+// Given:  Nothing.
+//
+// Task:   To add up the size of every block.
+//
+// Return: The bytes of address space the arena has reserved.
+size_t Arena::GetReservedBytes(void) {
+    size_t total = 0;
+    for (const Block& block : blocks) {
+        total += block.size;
+    }
+    return total;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "globals.h"
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+constexpr size_t ARENA_BLOCK_BYTES = size_t(64) << 20;   // Address space reserved at a time; pages are only backed once touched.
+constexpr size_t ARENA_HUGE_PAGE_BYTES = size_t(2) << 20; // Huge page size blocks are aligned and rounded to.
+constexpr size_t ARENA_ALIGNMENT = 64;                    // Every allocation starts on a cache line.
+
+// A position in an Arena returned by Mark, to which Rewind can later return.
+struct ArenaMark {
+    size_t block; // The index of the block being allocated from.
+    size_t used; // The bytes of that block in use.
+};
+
+// A bump allocator over large blocks of anonymous memory. Allocation is a pointer increment and memory is never
+// initialized unless asked for, so buffers only cost page faults where they are actually written. Memory is given
+// back in bulk with Rewind, after which the same pages are handed out again, already faulted in, to later passes and
+// runs. Blocks are backed by huge pages as ARENA_HUGE_PAGES asks, which cuts the number of page faults and TLB misses
+// on large buffers. The arena is not thread safe: threads must be handed their memory before they start.
+class Arena {
+public:
+	Arena();
+	~Arena(void);
+	Arena(const Arena&) = delete;
+	Arena& operator=(const Arena&) = delete;
+	void* AllocateBytes(const size_t bytes, const bool zeroed);
+	ArenaMark Mark(void);
+	void Rewind(const ArenaMark& mark);
+	void Release(void* pointer, const size_t bytes);
+	size_t GetReservedBytes(void);
+
+	// Given:  count        - The number of elements wanted.
+	//
+	// Task:   To allocate room for count elements, left uninitialized.
+	//
+	// Return: A pointer to the first element.
+	template <typename T>
+	T* Allocate(const size_t count) {
+		return static_cast<T*>(AllocateBytes(sizeof(T) * count, false));
+	}
+
+	// Given:  count        - The number of elements wanted.
+	//
+	// Task:   To allocate room for count elements with every byte zero. Pages fresh from the system are already zero,
+	//         so only memory reused after a Rewind is cleared.
+	//
+	// Return: A pointer to the first element.
+	template <typename T>
+	T* AllocateZeroed(const size_t count) {
+		return static_cast<T*>(AllocateBytes(sizeof(T) * count, true));
+	}
+private:
+	// One block of reserved address space.
+	struct Block {
+		char* base; // The first byte of the block.
+		size_t size; // The number of bytes in the block.
+		size_t used; // The bytes handed out.
+		size_t touched; // The bytes ever handed out, beyond which the pages are still as the system zeroed them.
+	};
+	bool Reserve(const size_t bytes);
+	std::vector<Block> blocks; // Every block reserved so far, in the order they were reserved.
+	size_t current; // The index of the block being allocated from.
+};
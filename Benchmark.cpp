@@ -0,0 +1,613 @@
+// Thomas McLaughlin
+
+/*
+Summary:
+
+          A benchmark of the sort, build and lookup phases, run on synthetic keys instead of KEY_FILE so results can be
+          reproduced on any host. For every key distribution and size asked for, the program times:
+
+          (1) Sorting the keys with the radix engine, the in-place radix sort and std::sort, and sorting key/value
+              records and float keys with the generic radix sort, checked against std::stable_sort and std::sort
+          (2) Building every table from the distinct sorted keys: HashTable under each hash policy, SwissTable,
+              RobinHoodTable, CuckooTable, DynamicHashTable, PerfectHashTable and std::unordered_map as the baseline
+          (3) Searching every table for keys that are present (hits) and keys that are not (misses)
+
+          Every phase is run --repeats times and the median is reported. Results are written as JSON, one record per
+          distribution, size, engine and phase, to standard output or to the file given with --output.
+
+          Usage: benchmark [--min-keys N] [--max-keys N] [--distributions a,b,...] [--repeats N] [--lookups N]
+                           [--seed N] [--threads N] [--output path]
+
+          Sizes run from 1K to 100M in powers of ten between --min-keys and --max-keys, 10M by default as 100M keys
+          need several gigabytes. Distributions are uniform, zipf, sorted, reverse, duplicates and clustered.
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Arena.h"
+#include "Cuckoo.h"
+#include "DynamicTable.h"
+#include "Hash.h"
+#include "PerfectHash.h"
+#include "Radix.h"
+#include "RadixGeneric.h"
+#include "RobinHood.h"
+#include "SwissTable.h"
+
+constexpr int BENCH_KEY_SIZES[] = { 1000, 10000, 100000, 1000000, 10000000, 100000000 };
+constexpr const char* BENCH_DISTRIBUTIONS[] = { "uniform", "zipf", "sorted", "reverse", "duplicates", "clustered" };
+constexpr int BENCH_VALUE_BITS = 30;            // Keys are twice a value below 2^30, so every odd key is a miss.
+constexpr double BENCH_ZIPF_EXPONENT = 0.99;    // Skew of the zipf distribution.
+constexpr int BENCH_DUPLICATE_RATIO = 100;      // Average repeats of every key in the duplicates distribution.
+constexpr int BENCH_CLUSTER_KEYS = 64;          // Consecutive values in every cluster of the clustered distribution.
+
+// The command line options of a run.
+struct BenchConfig {
+    int minKeys = 1000; // The smallest size run.
+    int maxKeys = 10000000; // The largest size run.
+    std::vector<std::string> distributions; // The distributions run, every one when empty.
+    int repeats = 3; // The runs of every phase the median is taken over.
+    int lookups = 1 << 20; // The hits and the misses searched for, at most the number of keys.
+    uint32_t seed = 42; // Seed of the key generator, so every run sees the same keys.
+    int threads = SORT_THREADS; // Threads for the radix sort and HashTable::BulkLoad, 0 for one per hardware thread.
+    std::string output; // The JSON file written, standard output when empty.
+};
+
+// One timed phase of one engine.
+struct BenchRecord {
+    std::string distribution; // The key distribution.
+    int keys; // The number of keys.
+    std::string engine; // The sort or table timed.
+    std::string phase; // sort, build, lookup_hit or lookup_miss.
+    long long operations; // Keys sorted or distinct keys inserted, or lookups made.
+    double seconds; // The median time of the phase.
+    long long checksum; // Keys found, or the sum of sorted keys, so the result is used and can be checked.
+};
+
+// A record sorted by the generic radix sort, carrying its input position so a stable order can be checked.
+struct KeyValue {
+    int key; // The sort key.
+    int value; // The position of the key in the input.
+};
+
+
+// Given:  argc         - The number of command line arguments.
+//         argv         - The command line arguments.
+//         config       - A BenchConfig which currently contains the defaults.
+//
+// Task:   To read the options given on the command line into config.
+//
+// Return: true or false        - True indicating every option was understood, False indicating the usage was printed.
+bool ParseArguments(const int argc, char** argv, BenchConfig& config);
+
+
+// Given:  distribution - The name of the distribution.
+//         count        - The number of keys wanted.
+//         seed         - Seed of the generator.
+//
+// Task:   To generate count non-negative even keys following the distribution.
+//
+// Return: The keys, in the order the distribution gives them.
+std::vector<int> GenerateKeys(const std::string& distribution, const int count, const uint32_t seed);
+
+
+// Given:  keys         - The generated keys.
+//         config       - The options of the run.
+//         distribution - The name of the distribution the keys follow.
+//         records      - The records so far.
+//
+// Task:   To time every sort, build and lookup phase over the keys, checking the generic sorts against the standard
+//         library and every table holds each distinct key.
+//
+// Return: true or false                    - True indicating every check passed, False indicating one failed.
+//         records (via reference)          - The records with those of the keys added.
+bool BenchmarkKeys(const std::vector<int>& keys, const BenchConfig& config, const std::string& distribution,
+                   std::vector<BenchRecord>& records);
+
+
+// Given:  config       - The options of the run.
+//         records      - Every record of the run.
+//         out          - The stream to write to.
+//
+// Task:   To write the run's options and records as a JSON object.
+//
+// Return: Nothing.
+void WriteJson(const BenchConfig& config, const std::vector<BenchRecord>& records, std::ostream& out);
+
+
+int main(int argc, char** argv) {
+    BenchConfig config;
+    if (!ParseArguments(argc, argv, config)) {
+        return 1;
+    }
+
+    std::vector<BenchRecord> records;
+    bool allPassed = true;
+    for (const char* distribution : BENCH_DISTRIBUTIONS) {
+        if (!config.distributions.empty() &&
+            std::find(config.distributions.begin(), config.distributions.end(), distribution) == config.distributions.end()) {
+            continue;
+        }
+        for (const int size : BENCH_KEY_SIZES) {
+            if (size < config.minKeys || size > config.maxKeys) {
+                continue;
+            }
+            std::cerr << distribution << " " << size << " keys" << std::endl; // Progress, kept off the JSON.
+            const std::vector<int> keys = GenerateKeys(distribution, size, config.seed);
+            allPassed = BenchmarkKeys(keys, config, distribution, records) && allPassed;
+        }
+    }
+
+    if (config.output.empty()) {
+        WriteJson(config, records, std::cout);
+        return allPassed ? 0 : 1;
+    }
+    std::ofstream outFile(config.output);
+    if (!outFile) {
+        std::cerr << "Output File Failed To Open" << std::endl;
+        return 1;
+    }
+    WriteJson(config, records, outFile);
+    return (outFile && allPassed) ? 0 : 1;
+}
+
+
+bool ParseArguments(const int argc, char** argv, BenchConfig& config) {
+    for (int i = 1; i < argc; i++) {
+        const std::string option = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << option << std::endl;
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (option == "--min-keys") {
+            config.minKeys = std::atoi(value.c_str());
+        }
+        else if (option == "--max-keys") {
+            config.maxKeys = std::atoi(value.c_str());
+        }
+        else if (option == "--distributions") {
+            std::stringstream list(value);
+            std::string name;
+            while (std::getline(list, name, ',')) {
+                config.distributions.push_back(name);
+            }
+        }
+        else if (option == "--repeats") {
+            config.repeats = std::max(1, std::atoi(value.c_str()));
+        }
+        else if (option == "--lookups") {
+            config.lookups = std::max(1, std::atoi(value.c_str()));
+        }
+        else if (option == "--seed") {
+            config.seed = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        }
+        else if (option == "--threads") {
+            config.threads = std::atoi(value.c_str());
+        }
+        else if (option == "--output") {
+            config.output = value;
+        }
+        else {
+            std::cerr << "Unknown option " << option << std::endl;
+            std::cerr << "Usage: benchmark [--min-keys N] [--max-keys N] [--distributions a,b,...] [--repeats N]"
+                      << " [--lookups N] [--seed N] [--threads N] [--output path]" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<int> GenerateKeys(const std::string& distribution, const int count, const uint32_t seed) {
+    std::mt19937_64 generator(seed ^ (static_cast<uint64_t>(count) << 32));
+    std::uniform_int_distribution<int> value(0, (1 << BENCH_VALUE_BITS) - 1);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<int> keys(count);
+
+    if (distribution == "zipf") {
+        // Inverse of the zipf CDF's continuous approximation, over a universe of count ranks. Ranks are scattered over
+        // the values by an odd multiplier, so the popular keys are not all small.
+        const double exponent = 1.0 - BENCH_ZIPF_EXPONENT;
+        const double span = std::pow(static_cast<double>(count), exponent) - 1.0;
+        for (int i = 0; i < count; i++) {
+            const uint64_t rank = static_cast<uint64_t>(std::pow(span * unit(generator) + 1.0, 1.0 / exponent));
+            keys[i] = static_cast<int>((rank * 0x9E3779B1u) & ((1u << BENCH_VALUE_BITS) - 1)) * 2;
+        }
+    }
+    else if (distribution == "duplicates") {
+        std::vector<int> distinct(std::max(1, count / BENCH_DUPLICATE_RATIO));
+        for (int& key : distinct) {
+            key = value(generator) * 2;
+        }
+        std::uniform_int_distribution<int> pick(0, static_cast<int>(distinct.size()) - 1);
+        for (int i = 0; i < count; i++) {
+            keys[i] = distinct[pick(generator)];
+        }
+    }
+    else if (distribution == "clustered") {
+        int base = 0;
+        for (int i = 0; i < count; i++) {
+            if (i % BENCH_CLUSTER_KEYS == 0) {
+                base = value(generator) & ~(BENCH_CLUSTER_KEYS - 1);
+            }
+            keys[i] = (base + i % BENCH_CLUSTER_KEYS) * 2;
+        }
+        std::shuffle(keys.begin(), keys.end(), generator);
+    }
+    else {
+        for (int i = 0; i < count; i++) {
+            keys[i] = value(generator) * 2;
+        }
+        if (distribution == "sorted") {
+            std::sort(keys.begin(), keys.end());
+        }
+        else if (distribution == "reverse") {
+            std::sort(keys.begin(), keys.end(), [](const int a, const int b) { return a > b; });
+        }
+    }
+    return keys;
+}
+
+// Given:  repeats      - The number of runs.
+//         prepare      - Called before every run, untimed.
+//         run          - The work timed, returning a checksum.
+//         checksum     - A long long which currently contains dummy information.
+//
+// Task:   To time run repeats times.
+//
+// Return: The median time in seconds.
+//         checksum (via reference)         - The checksum of the last run.
+template <typename Prepare, typename Run>
+double TimeMedian(const int repeats, Prepare prepare, Run run, long long& checksum) {
+    std::vector<double> times;
+    for (int r = 0; r < repeats; r++) {
+        prepare();
+        const auto start = std::chrono::steady_clock::now();
+        checksum = run();
+        const auto stop = std::chrono::steady_clock::now();
+        times.push_back(std::chrono::duration<double>(stop - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+// Given:  table        - A built table with a Search(key, Node&, int&) method.
+//         searchKeys   - The keys to search for.
+//         repeats      - The number of runs.
+//         checksum     - A long long which currently contains dummy information.
+//
+// Task:   To time searching table for every key of searchKeys.
+//
+// Return: The median time in seconds.
+//         checksum (via reference)         - The number of keys found.
+template <typename Table>
+double TimeSearches(Table& table, const std::vector<int>& searchKeys, const int repeats, long long& checksum) {
+    return TimeMedian(repeats, [] {}, [&] {
+        long long found = 0;
+        Node result;
+        int searchAttempts;
+        for (const int key : searchKeys) {
+            found += table.Search(key, result, searchAttempts) ? 1 : 0;
+        }
+        return found;
+    }, checksum);
+}
+
+// Given:  table        - An empty table with SetHead and HeadInsert methods.
+//         sortedKeys   - The keys to insert, in ascending order.
+//
+// Task:   To insert the keys in order, as the program inserts sorted keys.
+//
+// Return: The number of keys inserted.
+template <typename Table>
+long long InsertSorted(Table& table, const std::vector<int>& sortedKeys) {
+    Node record;
+    int prevBucket = -1;
+    long long inserted = 0;
+    for (size_t i = 0; i < sortedKeys.size(); i++) {
+        record.SetKeys(sortedKeys[i]);
+        inserted += (i == 0 ? table.SetHead(record, prevBucket) : table.HeadInsert(record, prevBucket)) ? 1 : 0;
+    }
+    return inserted;
+}
+
+bool BenchmarkKeys(const std::vector<int>& keys, const BenchConfig& config, const std::string& distribution,
+                   std::vector<BenchRecord>& records) {
+    const int count = static_cast<int>(keys.size());
+    const int repeats = config.repeats;
+    Arena arena;
+    std::vector<int> work(count);
+    long long checksum = 0;
+    double seconds;
+    bool passed = true;
+
+    // A build's checksum is the number of keys the table took, which must be every distinct key.
+    auto Record = [&](const std::string& engine, const std::string& phase, const long long operations) {
+        records.push_back({ distribution, count, engine, phase, operations, seconds, checksum });
+        if (phase == "build" && checksum != operations) {
+            std::cerr << engine << " Could Not Be Built Over " << operations << " Keys" << std::endl;
+            passed = false;
+        }
+    };
+    auto SumKeys = [&] {
+        long long sum = 0;
+        for (int i = 0; i < count; i += 1 + count / 1024) {
+            sum += work[i]; // A sample is enough to tell sorted output apart.
+        }
+        return sum;
+    };
+    auto Refill = [&] { std::copy(keys.begin(), keys.end(), work.begin()); };
+
+    // Sort phase. The arena is rewound after every run, so later runs reuse its pages as the program's own sorts do.
+    const ArenaMark mark = arena.Mark();
+    int* scratch = arena.Allocate<int>(count);
+    const ArenaMark sortMark = arena.Mark();
+    seconds = TimeMedian(repeats, Refill, [&] {
+        ParallelRadixSortKeys(work.data(), scratch, count, RADIX_DIGIT_BITS, config.threads, arena);
+        arena.Rewind(sortMark);
+        return SumKeys();
+    }, checksum);
+    Record("radix_sort", "sort", count);
+    seconds = TimeMedian(repeats, Refill, [&] { InPlaceRadixSortKeys(work.data(), count); return SumKeys(); }, checksum);
+    Record("radix_sort_in_place", "sort", count);
+    seconds = TimeMedian(repeats, Refill, [&] { std::sort(work.begin(), work.end()); return SumKeys(); }, checksum);
+    Record("std_sort", "sort", count);
+    arena.Rewind(mark);
+
+    // The generic radix sort, over records moved with their keys and over float keys of both signs. The output of the
+    // last run is checked against the standard library: std::stable_sort for the records, as the sort is stable.
+    {
+        std::vector<KeyValue> pairs(count);
+        std::vector<KeyValue> pairScratch(count);
+        auto RefillPairs = [&] {
+            for (int i = 0; i < count; i++) {
+                pairs[i] = { keys[i], i };
+            }
+        };
+        seconds = TimeMedian(repeats, RefillPairs, [&] {
+            GenericRadixSort<int>(pairs.data(), pairScratch.data(), count, [](const KeyValue& pair) { return pair.key; });
+            long long sum = 0;
+            for (int i = 0; i < count; i += 1 + count / 1024) {
+                sum += pairs[i].key;
+            }
+            return sum;
+        }, checksum);
+        Record("generic_radix_sort_records", "sort", count);
+        std::vector<KeyValue> expected(count);
+        for (int i = 0; i < count; i++) {
+            expected[i] = { keys[i], i };
+        }
+        std::stable_sort(expected.begin(), expected.end(),
+                         [](const KeyValue& a, const KeyValue& b) { return a.key < b.key; });
+        for (int i = 0; i < count; i++) {
+            if (pairs[i].key != expected[i].key || pairs[i].value != expected[i].value) {
+                std::cerr << "generic_radix_sort_records Differs From std::stable_sort At " << i << std::endl;
+                passed = false;
+                break;
+            }
+        }
+    }
+    {
+        std::vector<float> floats(count);
+        std::vector<float> floatScratch(count);
+        auto RefillFloats = [&] {
+            for (int i = 0; i < count; i++) {
+                floats[i] = static_cast<float>(keys[i]) * 0.5f - 5.0e8f;
+            }
+        };
+        seconds = TimeMedian(repeats, RefillFloats, [&] {
+            GenericRadixSort<float>(floats.data(), floatScratch.data(), count);
+            long long sum = 0;
+            for (int i = 0; i < count; i += 1 + count / 1024) {
+                sum += static_cast<long long>(floats[i]);
+            }
+            return sum;
+        }, checksum);
+        Record("generic_radix_sort_float", "sort", count);
+        std::vector<float> expected(floats);
+        RefillFloats();
+        std::sort(floats.begin(), floats.end());
+        if (floats != expected) {
+            std::cerr << "generic_radix_sort_float Differs From std::sort" << std::endl;
+            passed = false;
+        }
+    }
+
+    // Every table is built from the sorted keys, as the program builds its tables, but holds each key once: thousands
+    // of copies of a zipf key would all follow one probe sequence and time the collisions rather than the table.
+    std::vector<int> sortedKeys = work;
+    sortedKeys.erase(std::unique(sortedKeys.begin(), sortedKeys.end()), sortedKeys.end());
+    const int distinct = static_cast<int>(sortedKeys.size());
+    std::mt19937_64 generator(config.seed);
+    const int lookups = std::min(count, config.lookups);
+    std::vector<int> hitKeys(lookups);
+    std::vector<int> missKeys(lookups);
+    std::uniform_int_distribution<int> pick(0, count - 1);
+    for (int i = 0; i < lookups; i++) {
+        hitKeys[i] = keys[pick(generator)]; // Drawn from the input, so skewed distributions give skewed lookups.
+        missKeys[i] = keys[pick(generator)] + 1; // Every key is even, so one more is never present.
+    }
+
+    auto TimeLookups = [&](const std::string& engine, auto& table) {
+        seconds = TimeSearches(table, hitKeys, repeats, checksum);
+        Record(engine, "lookup_hit", lookups);
+        seconds = TimeSearches(table, missKeys, repeats, checksum);
+        Record(engine, "lookup_miss", lookups);
+    };
+
+    // HashTable under its default policy is reported as hash_table, and under every other policy with its name appended.
+    const std::pair<HashPolicy, std::string> hashPolicies[] = {
+        { static_cast<HashPolicy>(HASH_POLICY), "" }, { HASH_MULTIPLY_SHIFT, "_multiply_shift" }, { HASH_MIXER, "_mixer" } };
+    for (const auto& hashPolicy : hashPolicies) {
+        if (!hashPolicy.second.empty() && hashPolicy.first == HASH_POLICY) {
+            continue;
+        }
+        const std::string engine = "hash_table" + hashPolicy.second;
+        std::unique_ptr<HashTable> table;
+        seconds = TimeMedian(repeats, [&] { table.reset(); arena.Rewind(mark); }, [&] {
+            table.reset(new HashTable());
+            table->SetHashPolicy(hashPolicy.first);
+            table->Allocate(distinct, arena);
+            return table->BulkLoad(sortedKeys.data(), distinct, config.threads) ? static_cast<long long>(distinct) : -1;
+        }, checksum);
+        Record(engine, "build", distinct);
+        TimeLookups(engine, *table);
+
+        std::vector<SearchResult> results(lookups);
+        auto TimeBatch = [&](const std::vector<int>& searchKeys) {
+            return TimeMedian(repeats, [] {}, [&] {
+                table->SearchBatch(searchKeys.data(), lookups, results.data());
+                long long found = 0;
+                for (const SearchResult& result : results) {
+                    found += result.found ? 1 : 0;
+                }
+                return found;
+            }, checksum);
+        };
+        seconds = TimeBatch(hitKeys);
+        Record(engine + "_batch", "lookup_hit", lookups);
+        seconds = TimeBatch(missKeys);
+        Record(engine + "_batch", "lookup_miss", lookups);
+        table.reset();
+        arena.Rewind(mark);
+    }
+
+    {
+        std::unique_ptr<SwissTable> table;
+        seconds = TimeMedian(repeats, [&] { table.reset(); }, [&] {
+            table.reset(new SwissTable(distinct));
+            return InsertSorted(*table, sortedKeys);
+        }, checksum);
+        Record("swiss_table", "build", distinct);
+        TimeLookups("swiss_table", *table);
+    }
+
+    {
+        std::unique_ptr<RobinHoodTable> table;
+        seconds = TimeMedian(repeats, [&] { table.reset(); }, [&] {
+            table.reset(new RobinHoodTable(distinct));
+            return InsertSorted(*table, sortedKeys);
+        }, checksum);
+        Record("robin_hood_table", "build", distinct);
+        TimeLookups("robin_hood_table", *table);
+    }
+
+    {
+        std::unique_ptr<CuckooTable> table;
+        seconds = TimeMedian(repeats, [&] { table.reset(); }, [&] {
+            table.reset(new CuckooTable(distinct));
+            return InsertSorted(*table, sortedKeys);
+        }, checksum);
+        Record("cuckoo_table", "build", distinct);
+        TimeLookups("cuckoo_table", *table);
+    }
+
+    {
+        std::unique_ptr<DynamicHashTable> table;
+        seconds = TimeMedian(repeats, [&] { table.reset(); }, [&] {
+            table.reset(new DynamicHashTable());
+            long long inserted = 0;
+            for (const int key : sortedKeys) {
+                inserted += table->Insert(key) ? 1 : 0;
+            }
+            return inserted;
+        }, checksum);
+        Record("dynamic_hash_table", "build", distinct);
+        while (table->Maintain()) {
+            // Search leaves a resize the last inserts started alone, so finish it before timing lookups.
+        }
+        TimeLookups("dynamic_hash_table", *table);
+    }
+
+    {
+        std::unique_ptr<PerfectHashTable> table;
+        seconds = TimeMedian(repeats, [&] { table.reset(); }, [&] {
+            table.reset(new PerfectHashTable());
+            return table->Build(sortedKeys.data(), distinct) ? static_cast<long long>(table->GetOccupiedBuckets()) : -1;
+        }, checksum);
+        Record("perfect_hash_table", "build", distinct);
+        TimeLookups("perfect_hash_table", *table);
+    }
+
+    {
+        // The baseline stores a value per key, as the tables store a Node per key.
+        std::unique_ptr<std::unordered_map<int, int>> table;
+        seconds = TimeMedian(repeats, [&] { table.reset(); }, [&] {
+            table.reset(new std::unordered_map<int, int>());
+            table->reserve(distinct);
+            for (int i = 0; i < distinct; i++) {
+                table->emplace(sortedKeys[i], i);
+            }
+            return static_cast<long long>(table->size());
+        }, checksum);
+        Record("std_unordered_map", "build", distinct);
+
+        auto TimeFinds = [&](const std::vector<int>& searchKeys) {
+            return TimeMedian(repeats, [] {}, [&] {
+                long long found = 0;
+                for (const int key : searchKeys) {
+                    found += (table->find(key) != table->end()) ? 1 : 0;
+                }
+                return found;
+            }, checksum);
+        };
+        seconds = TimeFinds(hitKeys);
+        Record("std_unordered_map", "lookup_hit", lookups);
+        seconds = TimeFinds(missKeys);
+        Record("std_unordered_map", "lookup_miss", lookups);
+    }
+    return passed;
+}
+
+// Given:  text         - The text to be quoted.
+//
+// Task:   To quote text as a JSON string. Only names made by the program are quoted, so escaping quotes and
+//         backslashes is enough.
+//
+// Return: The quoted text.
+std::string JsonString(const std::string& text) {
+    std::string quoted = "\"";
+    for (const char c : text) {
+        if (c == '"' || c == '\\') {
+            quoted += '\\';
+        }
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+void WriteJson(const BenchConfig& config, const std::vector<BenchRecord>& records, std::ostream& out) {
+    out << "{\n";
+    out << "  \"config\": {\"min_keys\": " << config.minKeys << ", \"max_keys\": " << config.maxKeys
+        << ", \"repeats\": " << config.repeats << ", \"lookups\": " << config.lookups << ", \"seed\": " << config.seed
+        << ", \"threads\": " << config.threads << ", \"radix_digit_bits\": " << RADIX_DIGIT_BITS
+        << ", \"lookup_filter_bits\": " << LOOKUP_FILTER_BITS << ", \"arena_huge_pages\": " << ARENA_HUGE_PAGES << "},\n";
+    out << "  \"results\": [";
+    for (size_t i = 0; i < records.size(); i++) {
+        const BenchRecord& record = records[i];
+        char timing[96];
+        std::snprintf(timing, sizeof(timing), "\"seconds\": %.9f, \"ns_per_op\": %.3f", record.seconds,
+                      (record.operations > 0) ? record.seconds * 1e9 / record.operations : 0.0);
+        out << (i == 0 ? "\n" : ",\n") << "    {\"distribution\": " << JsonString(record.distribution)
+            << ", \"keys\": " << record.keys << ", \"engine\": " << JsonString(record.engine)
+            << ", \"phase\": " << JsonString(record.phase) << ", \"operations\": " << record.operations
+            << ", " << timing << ", \"checksum\": " << record.checksum << "}";
+    }
+    out << "\n  ]\n}\n";
+}
@@ -0,0 +1,197 @@
+#include "BloomFilter.h"
+
+#include <bitset>
+
+// Odd multipliers, one per word of a block, that turn the low half of a key's hash into a bit index for that word.
+static const uint32_t BLOOM_SALTS[BLOOM_BLOCK_WORDS] = {
+    0x47B6137Bu, 0x44974D91u, 0x8824AD5Bu, 0xA2B7289Du,
+    0x705495C7u, 0x2DF1424Bu, 0x9EFC4947u, 0x5C6BFB31u
+};
+
+// Given:  Nothing.
+//
+// Task:   To initialize a disabled filter, which reports every key as possibly present.
+//
+// Return: Nothing.
+BloomFilter::BloomFilter(void) {
+    blockCount = 0;
+    blocks = nullptr;
+}
+
+// Given:  Nothing.
+//
+// Task:   To destroy the filter and release any allocated memory.
+//
+// Return: Nothing.
+BloomFilter::~BloomFilter(void) {
+
+}
+
+// Given:  keyCount     - The number of keys the filter will hold.
+//         bitsPerKey   - The filter bits to spend on every key, 0 to leave the filter disabled.
+//
+// Task:   To allocate an empty filter of keyCount * bitsPerKey bits rounded up to whole blocks.
+//
+// Return: Nothing.
+void BloomFilter::Allocate(const int keyCount, const int bitsPerKey) {
+    blockCount = BlockCountFor(keyCount, bitsPerKey);
+    if (blockCount == 0) {
+        blockStorage.reset();
+        blocks = nullptr;
+        return;
+    }
+    blockStorage.reset(new BloomBlock[blockCount]);
+    blocks = blockStorage.get();
+    Clear();
+}
+
+// Given:  Nothing.
+//
+// Task:   To remove every key by zeroing all blocks. No reader may be testing keys meanwhile.
+//
+// Return: Nothing.
+void BloomFilter::Clear(void) {
+    for (int b = 0; b < blockCount; b++) {
+        for (int w = 0; w < BLOOM_BLOCK_WORDS; w++) {
+            blocks[b].words[w].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+// Given:  keyCount     - The number of keys the filter will hold.
+//         bitsPerKey   - The filter bits to spend on every key, 0 for a disabled filter.
+//
+// Task:   To round keyCount * bitsPerKey bits up to whole blocks.
+//
+// Return: The number of blocks Allocate would use, 0 when the filter would be disabled.
+int BloomFilter::BlockCountFor(const int keyCount, const int bitsPerKey) {
+    if (bitsPerKey <= 0 || keyCount <= 0) {
+        return 0;
+    }
+    const long long bits = static_cast<long long>(keyCount) * bitsPerKey;
+    const long long blockBits = BLOOM_BLOCK_WORDS * 32;
+    return static_cast<int>((bits + blockBits - 1) / blockBits);
+}
+
+// Given:  mappedBlocks - Filter blocks written out earlier by a filter of the same layout, e.g. in a mapped snapshot, or zeroed ones.
+//         mappedCount  - The number of blocks, 0 for a disabled filter.
+//
+// Task:   To use the given blocks in place, without copying them. They must outlive the filter's use of them.
+//
+// Return: Nothing.
+void BloomFilter::Attach(BloomBlock* mappedBlocks, const int mappedCount) {
+    blockStorage.reset();
+    blockCount = (mappedBlocks != nullptr) ? mappedCount : 0;
+    blocks = (blockCount > 0) ? mappedBlocks : nullptr;
+}
+
+// Given:  Nothing.
+//
+// Task:   To simply return blockCount.
+//
+// Return: blockCount      - The number of blocks in the filter.
+int BloomFilter::GetBlockCount(void) {
+    return blockCount;
+}
+
+// Given:  Nothing.
+//
+// Task:   To simply return the filter blocks, so they can be saved.
+//
+// Return: blocks          - The filter blocks, nullptr when the filter is disabled.
+const BloomBlock* BloomFilter::GetBlocks(void) {
+    return blocks;
+}
+
+// Given:  Nothing.
+//
+// Task:   To tell whether the filter was allocated.
+//
+// Return: true or false        - True indicating the filter holds bits, False indicating every key passes it.
+bool BloomFilter::IsEnabled(void) {
+    return blockCount > 0;
+}
+
+// Given:  key  - Integer representing the key to be hashed.
+//
+// Task:   To mix the key into 64 bits.
+//
+// Return: The hash of the key.
+uint64_t BloomFilter::Hash(const int key) {
+    uint64_t x = static_cast<uint64_t>(static_cast<uint32_t>(key)) * 0x9E3779B97F4A7C15ull;
+    x ^= x >> 32;
+    x *= 0xD6E8FEB86659FD93ull;
+    return x ^ (x >> 32);
+}
+
+// Given:  key  - The key whose block is wanted.
+//
+// Task:   To find the block the key's bits live in, so callers can prefetch it.
+//
+// Return: The key's block, or nullptr when the filter is disabled.
+const BloomBlock* BloomFilter::GetBlock(const int key) {
+    if (blockCount == 0) {
+        return nullptr;
+    }
+    const uint64_t hash = Hash(key);
+    return &blocks[((hash >> 32) * static_cast<uint64_t>(blockCount)) >> 32];
+}
+
+// Given:  key  - The key to be added.
+//
+// Task:   To set the key's bit in every word of its block.
+//
+// Return: Nothing.
+void BloomFilter::Insert(const int key) {
+    if (blockCount == 0) {
+        return;
+    }
+    const uint64_t hash = Hash(key);
+    BloomBlock& block = blocks[((hash >> 32) * static_cast<uint64_t>(blockCount)) >> 32];
+    for (int w = 0; w < BLOOM_BLOCK_WORDS; w++) {
+        const uint32_t bit = (static_cast<uint32_t>(hash) * BLOOM_SALTS[w]) >> 27;
+        block.words[w].fetch_or(1u << bit, std::memory_order_relaxed);
+    }
+}
+
+// Given:  key  - The key to be tested.
+//
+// Task:   To check the key's bit in every word of its block.
+//
+// Return: true or false        - True indicating the key may be present, False indicating it certainly is not.
+bool BloomFilter::MayContain(const int key) {
+    if (blockCount == 0) {
+        return true;
+    }
+    const uint64_t hash = Hash(key);
+    const BloomBlock& block = blocks[((hash >> 32) * static_cast<uint64_t>(blockCount)) >> 32];
+    for (int w = 0; w < BLOOM_BLOCK_WORDS; w++) {
+        const uint32_t bit = (static_cast<uint32_t>(hash) * BLOOM_SALTS[w]) >> 27;
+        if ((block.words[w].load(std::memory_order_relaxed) & (1u << bit)) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Given:  Nothing.
+//
+// Task:   To estimate the chance that an absent key passes the filter. An absent key lands in a uniformly chosen block
+//         and passes when each of the eight bits it tests is set, so the rate is the average over blocks of the product
+//         of every word's fraction of set bits.
+//
+// Return: The estimated false positive rate, 1 when the filter is disabled.
+double BloomFilter::EstimatedFalsePositiveRate(void) {
+    if (blockCount == 0) {
+        return 1.0;
+    }
+    double total = 0.0;
+    for (int b = 0; b < blockCount; b++) {
+        double pass = 1.0;
+        for (int w = 0; w < BLOOM_BLOCK_WORDS; w++) {
+            pass *= std::bitset<32>(blocks[b].words[w].load(std::memory_order_relaxed)).count() / 32.0;
+        }
+        total += pass;
+    }
+    return total / blockCount;
+}
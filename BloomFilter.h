@@ -0,0 +1,39 @@
+#pragma once
+
+#include "globals.h"
+
+#include <atomic>
+#include <cstdint>
+
+constexpr int BLOOM_BLOCK_WORDS = 8; // 32-bit words per block: a key sets one bit in each word of its block.
+
+// One 32 byte block of a BloomFilter. Every key touches a single block, so a lookup costs one cache miss.
+struct alignas(32) BloomBlock {
+    std::atomic<uint32_t> words[BLOOM_BLOCK_WORDS];
+};
+
+// A split block Bloom filter. A key picks a block from the high half of its hash, then the low half, multiplied by a
+// different odd constant per word, picks one bit in each of the block's eight words. A key that was inserted is always
+// reported as possibly present; a key that was not is reported as absent except at the false positive rate. Bits are
+// set with atomic ors, so several threads may insert at once and readers may test keys while a writer inserts.
+class BloomFilter {
+public:
+	BloomFilter();
+	~BloomFilter(void);
+	void Allocate(const int keyCount, const int bitsPerKey);
+	bool IsEnabled(void);
+	void Clear(void);
+	void Insert(const int key);
+	bool MayContain(const int key);
+	const BloomBlock* GetBlock(const int key);
+	double EstimatedFalsePositiveRate(void);
+	int GetBlockCount(void);
+	const BloomBlock* GetBlocks(void);
+	void Attach(BloomBlock* mappedBlocks, const int mappedCount);
+	static int BlockCountFor(const int keyCount, const int bitsPerKey);
+private:
+	uint64_t Hash(const int key);
+	int blockCount; // The number of blocks, 0 when the filter is disabled.
+	std::unique_ptr<BloomBlock[]> blockStorage; // Owns the blocks unless they were attached from a snapshot or arena.
+	BloomBlock* blocks; // The filter bits, in blockStorage, an arena or a snapshot mapping.
+};
@@ -0,0 +1,383 @@
+#include "Cuckoo.h"
+
+#include <utility>
+
+// Given:  Nothing.
+//
+// Task:   To initialize an empty table of a single bucket.
+//
+// Return: Nothing.
+CuckooTable::CuckooTable(void) {
+    Allocate(1);
+}
+
+// Given:  size   - The number of keys the table must hold.
+//
+// Task:   To initialize an empty table with enough buckets to hold size keys at CUCKOO_MAX_LOAD_PERCENT occupancy.
+//
+// Return: Nothing.
+CuckooTable::CuckooTable(const int size) {
+    Allocate(size);
+}
+
+// Given:  Nothing.
+//
+// Task:   To destroy the table and release any allocated memory.
+//
+// Return: Nothing.
+CuckooTable::~CuckooTable(void) {
+
+}
+
+// Given:  size   - The number of keys the table must hold.
+//
+// Task:   To allocate empty buckets for size keys at CUCKOO_MAX_LOAD_PERCENT occupancy.
+//
+// Return: Nothing.
+void CuckooTable::Allocate(const int size) {
+    const long long slotsNeeded = (static_cast<long long>(size) * 100 + CUCKOO_MAX_LOAD_PERCENT - 1) / CUCKOO_MAX_LOAD_PERCENT;
+    bucketCount = static_cast<int>((slotsNeeded + CUCKOO_BUCKET_SLOTS - 1) / CUCKOO_BUCKET_SLOTS);
+    if (bucketCount < 1) {
+        bucketCount = 1;
+    }
+    occupiedBuckets = 0;
+    headKey = 0;
+    tailKey = 0;
+    kickState = 0x9E3779B9u;
+    stashCount = 0;
+
+    buckets.reset(new CuckooBucket[bucketCount]);
+    links.reset(new CuckooLinks[bucketCount * CUCKOO_BUCKET_SLOTS + CUCKOO_STASH_SIZE]); // Only read for stored keys.
+    for (int b = 0; b < bucketCount; b++) {
+        for (int slot = 0; slot < CUCKOO_BUCKET_SLOTS; slot++) {
+            buckets[b].keys[slot] = CUCKOO_EMPTY;
+        }
+    }
+}
+
+// Given:  Nothing.
+//
+// Task:   To count the slots of every bucket.
+//
+// Return: The number of keys the buckets can hold.
+int CuckooTable::GetTableSize(void) {
+    return bucketCount * CUCKOO_BUCKET_SLOTS;
+}
+
+// Given:  Nothing.
+//
+// Task:   To simply return occupiedBuckets.
+//
+// Return: occupiedBuckets        - The number of keys in the table.
+int CuckooTable::GetOccupiedBuckets(void) {
+    return occupiedBuckets;
+}
+
+// Given:  Nothing.
+//
+// Task:   To simply return stashCount.
+//
+// Return: stashCount     - The number of keys in the stash, which only fills when the buckets are crowded.
+int CuckooTable::GetStashCount(void) {
+    return stashCount;
+}
+
+// Given:  key        - The key to be hashed.
+//         first      - An integer which currently contains dummy information.
+//         second     - An integer which currently contains dummy information.
+//
+// Task:   To mix the key into 64 bits and map each half onto the buckets with a multiply rather than a division.
+//
+// Return: first (via reference)        - The first bucket the key may live in.
+//         second (via reference)       - The second bucket, rarely the same as the first.
+void CuckooTable::Buckets(const int key, int& first, int& second) {
+    uint64_t hash = static_cast<uint64_t>(static_cast<uint32_t>(key)) * 0x9E3779B97F4A7C15ull;
+    hash ^= hash >> 32;
+    hash *= 0xD6E8FEB86659FD93ull;
+    hash ^= hash >> 32;
+    first = static_cast<int>(((hash & 0xFFFFFFFFull) * static_cast<uint64_t>(bucketCount)) >> 32);
+    second = static_cast<int>(((hash >> 32) * static_cast<uint64_t>(bucketCount)) >> 32);
+}
+
+// Given:  key                - The key to be found.
+//         searchAttempts     - An integer which currently contains dummy information.
+//
+// Task:   To look for key in its two buckets, then in the stash if it holds anything.
+//
+// Return: The location of key: bucket * CUCKOO_BUCKET_SLOTS + slot, or for the stash, the table size plus the stash
+//         entry. -1 when key is not present.
+//         searchAttempts (via reference)   - The number of buckets read, counting the stash as one.
+int CuckooTable::Find(const int key, int& searchAttempts) {
+    int first;
+    int second;
+    Buckets(key, first, second);
+    const int candidates[2] = { first, second };
+    searchAttempts = 0;
+    for (const int bucket : candidates) {
+        searchAttempts++;
+        for (int slot = 0; slot < CUCKOO_BUCKET_SLOTS; slot++) {
+            if (buckets[bucket].keys[slot] == key) {
+                return bucket * CUCKOO_BUCKET_SLOTS + slot;
+            }
+        }
+        if (second == first) {
+            break;
+        }
+    }
+    if (stashCount > 0) {
+        searchAttempts++;
+        for (int entry = 0; entry < stashCount; entry++) {
+            if (stashKeys[entry] == key) {
+                return GetTableSize() + entry;
+            }
+        }
+    }
+    return -1;
+}
+
+// Given:  bucket     - A bucket.
+//
+// Task:   To find a free slot in the bucket.
+//
+// Return: The first free slot, or -1 when the bucket is full.
+int CuckooTable::FreeSlot(const int bucket) {
+    for (int slot = 0; slot < CUCKOO_BUCKET_SLOTS; slot++) {
+        if (buckets[bucket].keys[slot] == CUCKOO_EMPTY) {
+            return slot;
+        }
+    }
+    return -1;
+}
+
+// Given:  key        - A key not in the table.
+//         keyLinks   - Its links in the ordered list.
+//
+// Task:   To store key in a free slot of one of its buckets. When both are full a random key of one is evicted to make
+//         room and is carried to its own other bucket, and so on for up to CUCKOO_MAX_KICKS evictions. The key still
+//         carried after that goes to the stash. Nothing is moved unless the stash has room, so a failed insert leaves
+//         the table as it was.
+//
+// Return: true or false        - True indicating key was stored, False indicating both buckets and the stash are full.
+bool CuckooTable::Place(const int key, const CuckooLinks& keyLinks) {
+    int first;
+    int second;
+    Buckets(key, first, second);
+    for (const int bucket : { first, second }) {
+        const int slot = FreeSlot(bucket);
+        if (slot >= 0) {
+            buckets[bucket].keys[slot] = key;
+            links[bucket * CUCKOO_BUCKET_SLOTS + slot] = keyLinks;
+            return true;
+        }
+    }
+    if (stashCount >= CUCKOO_STASH_SIZE) {
+        return false;
+    }
+
+    int carriedKey = key;
+    CuckooLinks carriedLinks = keyLinks;
+    kickState ^= kickState << 13;
+    kickState ^= kickState >> 17;
+    kickState ^= kickState << 5;
+    int bucket = (kickState & 1) ? first : second;
+    for (int kick = 0; kick < CUCKOO_MAX_KICKS; kick++) {
+        kickState ^= kickState << 13;
+        kickState ^= kickState >> 17;
+        kickState ^= kickState << 5;
+        const int victim = bucket * CUCKOO_BUCKET_SLOTS + static_cast<int>(kickState % CUCKOO_BUCKET_SLOTS);
+        std::swap(carriedKey, buckets[bucket].keys[victim % CUCKOO_BUCKET_SLOTS]);
+        std::swap(carriedLinks, links[victim]);
+
+        int victimFirst;
+        int victimSecond;
+        Buckets(carriedKey, victimFirst, victimSecond);
+        bucket = (bucket == victimFirst) ? victimSecond : victimFirst;
+        const int slot = FreeSlot(bucket);
+        if (slot >= 0) {
+            buckets[bucket].keys[slot] = carriedKey;
+            links[bucket * CUCKOO_BUCKET_SLOTS + slot] = carriedLinks;
+            return true;
+        }
+    }
+
+    stashKeys[stashCount] = carriedKey;
+    links[GetTableSize() + stashCount] = carriedLinks;
+    stashCount++;
+    return true;
+}
+
+// Given:  key            - The key to be added, larger than every key already in the table.
+//         prevBucket     - An integer which currently contains dummy information.
+//
+// Task:   To store key and link it after the largest key.
+//
+// Return: true or false                    - True indicating key was added, False indicating there is no room, or key
+//                                            is the sentinel or not larger than every key in the table.
+//         prevBucket (via reference)       - The location key was stored at. Later inserts and erases may move it.
+bool CuckooTable::Append(const int key, int& prevBucket) {
+    if (key == CUCKOO_EMPTY || (occupiedBuckets > 0 && key <= tailKey)) {
+        return false;
+    }
+    if (!Place(key, { tailKey, key })) {
+        return false;
+    }
+    int attempts;
+    if (occupiedBuckets > 0) {
+        links[Find(tailKey, attempts)].nextKey = key;
+    }
+    else {
+        headKey = key;
+    }
+    tailKey = key;
+    occupiedBuckets++;
+    prevBucket = Find(key, attempts);
+    return true;
+}
+
+// Given:  headNode            - A Struct of Node which is the first record to be added.
+//         prevBucket          - Integer representing the location of the record inserted before headNode, here it is ignored.
+//
+// Task:   To insert the first record into the empty table, which starts the ordered list.
+//
+// Return: true or false                    - True indicating the record was added, False indicating the table is not empty.
+//         prevBucket (via reference)       - The location the record was stored at.
+bool CuckooTable::SetHead(Node headNode, int& prevBucket) {
+    if (occupiedBuckets > 0) {
+        return false;
+    }
+    return Append(headNode.GetKey(), prevBucket);
+}
+
+// Given:  headNode            - A Struct of Node which is the next record to be added, larger than every key already in the table.
+//         prevBucket          - Integer representing the location of the record inserted before headNode. Inserts move
+//                               keys, so the list is extended from the largest key instead.
+//
+// Task:   To insert the record whilst retaining the order of the list.
+//
+// Return: true or false                    - True indicating the record was added, False indicating there is no room or
+//                                            the key is out of order.
+//         prevBucket (via reference)       - The location the record was stored at.
+bool CuckooTable::HeadInsert(Node headNode, int& prevBucket) {
+    return Append(headNode.GetKey(), prevBucket);
+}
+
+// Given:  key    - The key to be erased.
+//
+// Task:   To unlink key from the ordered list and free its slot, then move any stashed key whose bucket now has room
+//         back out of the stash.
+//
+// Return: true or false        - True indicating key was erased, False indicating it was not present.
+bool CuckooTable::Erase(const int key) {
+    int attempts;
+    const int location = Find(key, attempts);
+    if (location < 0) {
+        return false;
+    }
+
+    const CuckooLinks keyLinks = links[location];
+    if (key == headKey) {
+        headKey = keyLinks.nextKey;
+    }
+    else {
+        links[Find(keyLinks.prevKey, attempts)].nextKey = keyLinks.nextKey;
+    }
+    if (key == tailKey) {
+        tailKey = keyLinks.prevKey;
+    }
+    else {
+        links[Find(keyLinks.nextKey, attempts)].prevKey = keyLinks.prevKey;
+    }
+
+    if (location < GetTableSize()) {
+        buckets[location / CUCKOO_BUCKET_SLOTS].keys[location % CUCKOO_BUCKET_SLOTS] = CUCKOO_EMPTY;
+    }
+    else {
+        const int entry = location - GetTableSize();
+        stashCount--;
+        stashKeys[entry] = stashKeys[stashCount];
+        links[location] = links[GetTableSize() + stashCount];
+    }
+    occupiedBuckets--;
+
+    for (int entry = stashCount - 1; entry >= 0; entry--) {
+        int first;
+        int second;
+        Buckets(stashKeys[entry], first, second);
+        for (const int bucket : { first, second }) {
+            const int slot = FreeSlot(bucket);
+            if (slot >= 0) {
+                buckets[bucket].keys[slot] = stashKeys[entry];
+                links[bucket * CUCKOO_BUCKET_SLOTS + slot] = links[GetTableSize() + entry];
+                stashCount--;
+                stashKeys[entry] = stashKeys[stashCount];
+                links[GetTableSize() + entry] = links[GetTableSize() + stashCount];
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+// Given:  searchKey          - An integer representing the key wished to be searched for.
+//         result             - A Struct of Node which contains dummy information.
+//         searchAttempts     - An integer which currently contains dummy information.
+//
+// Task:   To search the key's two buckets, and the stash, for searchKey.
+//
+// Return: true or false                    - True indicating the key was found, False indicating it was not.
+//         result (via reference)           - A Node holding the key and the buckets read to reach it.
+//         searchAttempts (via reference)   - The number of buckets read, at most three counting the stash.
+bool CuckooTable::Search(const int searchKey, Node& result, int& searchAttempts) {
+    if (searchKey == CUCKOO_EMPTY) {
+        searchAttempts = 0;
+        return false;
+    }
+    if (Find(searchKey, searchAttempts) < 0) {
+        return false;
+    }
+    result.SetKeys(searchKey);
+    result.SetInitialAttempts(searchAttempts);
+    result.SetOccupancy(true);
+    return true;
+}
+
+// Given:  key    - An integer which currently contains dummy information.
+//
+// Task:   To find the smallest key.
+//
+// Return: true or false                - True indicating the table holds a key, False indicating it is empty.
+//         key (via reference)          - The smallest key.
+bool CuckooTable::GetFirst(int& key) {
+    key = headKey;
+    return occupiedBuckets > 0;
+}
+
+// Given:  key        - A key in the table.
+//         nextKey    - An integer which currently contains dummy information.
+//
+// Task:   To follow the ordered list one step from key.
+//
+// Return: true or false                - True indicating there is a larger key, False indicating key is the largest
+//                                        or is not in the table.
+//         nextKey (via reference)      - The next larger key.
+bool CuckooTable::GetNext(const int key, int& nextKey) {
+    int attempts;
+    const int location = Find(key, attempts);
+    if (location < 0 || key == tailKey) {
+        return false;
+    }
+    nextKey = links[location].nextKey;
+    return true;
+}
+
+// Given:  Nothing.
+//
+// Task:   To print the keys in ascending order by following the ordered list from the smallest key.
+//
+// Return: Nothing.
+void CuckooTable::PrintList(void) {
+    int key;
+    for (bool more = GetFirst(key); more; more = GetNext(key, key)) {
+        std::cout << "Key: " << key << ", ModKey: " << key * 10 << std::endl;
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "globals.h"
+#include "node.h"
+
+#include <climits>
+#include <cstdint>
+
+constexpr int CUCKOO_BUCKET_SLOTS = 8;          // Keys per bucket: 32 bytes, so a bucket never straddles a cache line.
+constexpr int CUCKOO_MAX_LOAD_PERCENT = 95;     // Occupancy the table is sized for.
+constexpr int CUCKOO_MAX_KICKS = 500;           // Keys displaced by one insert before the one left over goes to the stash.
+constexpr int CUCKOO_STASH_SIZE = 8;            // Keys that found no bucket, checked by every search that misses both.
+constexpr int CUCKOO_EMPTY = INT_MIN;           // Marks a free slot, so it cannot itself be stored as a key.
+
+// One bucket of a CuckooTable.
+struct alignas(32) CuckooBucket {
+    int keys[CUCKOO_BUCKET_SLOTS]; // The keys of the bucket, CUCKOO_EMPTY in free slots.
+};
+
+// The neighbours of a key in the ordered list of a CuckooTable. Links are keys rather than slots because inserts move
+// keys between buckets.
+struct CuckooLinks {
+    int prevKey; // The next smaller key, valid unless this is the smallest key.
+    int nextKey; // The next larger key, valid unless this is the largest key.
+};
+
+// A bucketized cuckoo hash table. Every key may live in any slot of exactly two buckets picked by two hashes, so a
+// search reads at most two buckets, and the small stash, whatever the load. An insert that finds both buckets full
+// evicts a key to its other bucket, and so on, for at most CUCKOO_MAX_KICKS steps; a key still left over goes to the
+// stash. With eight slots per bucket this keeps working at 95% occupancy, against a third for HashTable.
+class CuckooTable {
+public:
+	CuckooTable();
+	CuckooTable(const int size);
+	~CuckooTable(void);
+	int GetTableSize(void);
+	int GetOccupiedBuckets(void);
+	int GetStashCount(void);
+	bool SetHead(Node headNode, int& prevBucket);
+	bool HeadInsert(Node headNode, int& prevBucket);
+	bool Erase(const int key);
+	bool Search(const int searchKey, Node& result, int& searchAttempts);
+	bool GetFirst(int& key);
+	bool GetNext(const int key, int& nextKey);
+	void PrintList(void);
+private:
+	void Allocate(const int size);
+	void Buckets(const int key, int& first, int& second);
+	int Find(const int key, int& searchAttempts);
+	int FreeSlot(const int bucket);
+	bool Place(const int key, const CuckooLinks& keyLinks);
+	bool Append(const int key, int& prevBucket);
+	int bucketCount; // The number of buckets.
+	int occupiedBuckets; // The number of keys in the table, stash included.
+	int headKey; // The smallest key, valid while the table is not empty.
+	int tailKey; // The largest key, valid while the table is not empty.
+	uint32_t kickState; // Xorshift state choosing which key an insert evicts.
+	std::unique_ptr<CuckooBucket[]> buckets; // The buckets, read by searches.
+	std::unique_ptr<CuckooLinks[]> links; // links[bucket * CUCKOO_BUCKET_SLOTS + slot], then one per stash entry.
+	int stashKeys[CUCKOO_STASH_SIZE]; // The keys that found no bucket.
+	int stashCount; // The number of keys in the stash.
+};
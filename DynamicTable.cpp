@@ -0,0 +1,414 @@
+#include "DynamicTable.h"
+
+#include <algorithm>
+#include <cstdint>
+
+// Given:  Nothing.
+//
+// Task:   To initialize an empty table with a small bucket array.
+//
+// Return: Nothing.
+DynamicHashTable::DynamicHashTable(void) : DynamicHashTable(8) {
+
+}
+
+// Given:  size   - The number of keys expected, used to size the first bucket array.
+//
+// Task:   To initialize an empty table whose first array holds size keys below the 3/4 resize threshold.
+//
+// Return: Nothing.
+DynamicHashTable::DynamicHashTable(const int size) {
+    int capacity = 8;
+    while (static_cast<long long>(capacity) * 3 < static_cast<long long>(size) * 4 + 4) {
+        capacity *= 2;
+    }
+    Allocate(current, capacity);
+    previous.capacity = 0;
+    previous.shift = 32;
+    previous.used = 0;
+    migrating = false;
+    migrateCursor = 0;
+    occupiedBuckets = 0;
+    hasHead = false;
+    headKey = 0;
+}
+
+// Given:  Nothing.
+//
+// Task:   To destroy the table and release any allocated memory.
+//
+// Return: Nothing.
+DynamicHashTable::~DynamicHashTable(void) {
+
+}
+
+// Given:  array      - The bucket array to be allocated.
+//         capacity   - The number of buckets, a power of two.
+//
+// Task:   To allocate capacity empty buckets for array.
+//
+// Return: array (via reference)    - The empty bucket array.
+void DynamicHashTable::Allocate(DynamicArray& array, const int capacity) {
+    array.buckets.reset(new DynamicBucket[capacity]);
+    for (int i = 0; i < capacity; i++) {
+        array.buckets[i].state = BUCKET_EMPTY;
+    }
+    array.capacity = capacity;
+    array.shift = 32;
+    for (int bits = capacity; bits > 1; bits >>= 1) {
+        array.shift--;
+    }
+    array.used = 0;
+}
+
+// Given:  array    - The bucket array being probed.
+//         key      - The key to be hashed.
+//
+// Task:   To pick the key's home bucket by multiply-shift hashing, which needs no division.
+//
+// Return: The home bucket of key in array.
+int DynamicHashTable::Home(const DynamicArray& array, const int key) {
+    uint32_t hash = static_cast<uint32_t>(key) * 0x9E3779B9u;
+    return array.shift >= 32 ? 0 : static_cast<int>(hash >> array.shift);
+}
+
+// Given:  array              - The bucket array to search.
+//         key                - The key wished to be found.
+//         searchAttempts     - The number of buckets probed so far, added to.
+//
+// Task:   To probe array linearly from the key's home bucket, passing tombstones, until the key or an empty bucket.
+//
+// Return: The bucket holding key, or -1 when key is not in array.
+//         searchAttempts (via reference)   - Increased by the number of buckets probed.
+int DynamicHashTable::FindIn(DynamicArray& array, const int key, int& searchAttempts) {
+    if (array.capacity == 0) {
+        return -1;
+    }
+    const int mask = array.capacity - 1;
+    int bucket = Home(array, key);
+    for (int i = 0; i < array.capacity; i++) {
+        searchAttempts++;
+        const DynamicBucket& candidate = array.buckets[bucket];
+        if (candidate.state == BUCKET_EMPTY) {
+            return -1;
+        }
+        if ((candidate.state & BUCKET_FULL) && candidate.key == key) {
+            return bucket;
+        }
+        bucket = (bucket + 1) & mask;
+    }
+    return -1;
+}
+
+// Given:  key                - The key wished to be found.
+//         searchAttempts     - An integer which currently contains dummy information.
+//
+// Task:   To find the bucket of key in the current array or, while migrating, in the previous array.
+//
+// Return: A pointer to the bucket holding key, nullptr when key is not in the table.
+//         searchAttempts (via reference)   - The number of buckets probed.
+DynamicBucket* DynamicHashTable::Locate(const int key, int& searchAttempts) {
+    searchAttempts = 0;
+    int bucket = FindIn(current, key, searchAttempts);
+    if (bucket >= 0) {
+        return &current.buckets[bucket];
+    }
+    if (migrating) {
+        bucket = FindIn(previous, key, searchAttempts);
+        if (bucket >= 0) {
+            return &previous.buckets[bucket];
+        }
+    }
+    return nullptr;
+}
+
+// Given:  array    - The bucket array to place into, with room below the resize threshold.
+//         bucket   - The bucket contents to be placed, for a key not yet in array.
+//
+// Task:   To store bucket in the first empty or tombstone bucket on its probe sequence.
+//
+// Return: Nothing.
+void DynamicHashTable::PlaceIn(DynamicArray& array, const DynamicBucket& bucket) {
+    const int mask = array.capacity - 1;
+    int index = Home(array, bucket.key);
+    while (array.buckets[index].state & BUCKET_FULL) {
+        index = (index + 1) & mask;
+    }
+    if (array.buckets[index].state == BUCKET_EMPTY) {
+        array.used++; // Reusing a tombstone does not use up another bucket.
+    }
+    array.buckets[index] = bucket;
+}
+
+// Given:  steps    - The number of buckets of the previous array to move.
+//
+// Task:   To move the next steps buckets of the previous array into the current one, leaving tombstones behind so
+//         probe sequences through the previous array stay intact. The previous array is freed once it is empty.
+//
+// Return: Nothing.
+void DynamicHashTable::MigrateStep(const int steps) {
+    if (!migrating) {
+        return;
+    }
+    const int last = std::min(previous.capacity, migrateCursor + steps);
+    for (; migrateCursor < last; migrateCursor++) {
+        DynamicBucket& bucket = previous.buckets[migrateCursor];
+        if (bucket.state & BUCKET_FULL) {
+            PlaceIn(current, bucket);
+            bucket.state = BUCKET_TOMBSTONE;
+        }
+    }
+    if (migrateCursor == previous.capacity) {
+        previous.buckets.reset();
+        previous.capacity = 0;
+        previous.used = 0;
+        migrating = false;
+    }
+}
+
+// Given:  Nothing.
+//
+// Task:   To start a new bucket array when one more insert would take the current array past 3/4 used. The new array
+//         doubles when most used buckets hold keys, and keeps its size when most are tombstones, which only need
+//         clearing. Any migration still running is finished first.
+//
+// Return: Nothing.
+void DynamicHashTable::GrowIfNeeded(void) {
+    if (static_cast<long long>(current.used + 1) * 4 <= static_cast<long long>(current.capacity) * 3) {
+        return;
+    }
+    MigrateStep(previous.capacity); // Normally long finished, the migration step outpaces inserts.
+
+    int capacity = current.capacity;
+    if (static_cast<long long>(occupiedBuckets + 1) * 8 > static_cast<long long>(capacity) * 3) {
+        capacity *= 2;
+    }
+    previous = std::move(current);
+    Allocate(current, capacity);
+    migrating = true;
+    migrateCursor = 0;
+}
+
+// Given:  key            - A key not in the table.
+//         predecessor    - An integer which currently contains dummy information.
+//
+// Task:   To find the largest key in the table smaller than key, walking the ordered list from the closest fence
+//         below key. When the walk is long, the key it stopped at becomes a new fence.
+//
+// Return: true or false                    - True indicating a smaller key exists, False indicating key would be the smallest.
+//         predecessor (via reference)      - The largest key smaller than key.
+bool DynamicHashTable::FindPredecessor(const int key, int& predecessor) {
+    if (!hasHead || headKey > key) {
+        return false;
+    }
+
+    std::vector<int>::iterator fence = std::upper_bound(fences.begin(), fences.end(), key);
+    int position = static_cast<int>(fence - fences.begin());
+    int walkKey = (position == 0) ? headKey : fences[position - 1];
+
+    int attempts;
+    int steps = 0;
+    DynamicBucket* bucket = Locate(walkKey, attempts);
+    while ((bucket->state & BUCKET_HAS_NEXT) && bucket->nextKey < key) {
+        walkKey = bucket->nextKey;
+        bucket = Locate(walkKey, attempts);
+        steps++;
+    }
+
+    if (steps > FENCE_SPACING) {
+        fences.insert(fences.begin() + position, walkKey);
+    }
+    predecessor = walkKey;
+    return true;
+}
+
+// Given:  key    - The key to be added.
+//
+// Task:   To add key to the table and link it into the ordered list between its neighbours.
+//
+// Return: true or false        - True indicating key was added, False indicating it was already present.
+bool DynamicHashTable::Insert(const int key) {
+    MigrateStep(MIGRATE_STEP);
+
+    int attempts;
+    if (Locate(key, attempts) != nullptr) {
+        return false;
+    }
+    GrowIfNeeded();
+
+    DynamicBucket bucket;
+    bucket.key = key;
+    bucket.state = BUCKET_FULL;
+
+    int predecessor;
+    bool hasPredecessor = FindPredecessor(key, predecessor);
+    bool hasSuccessor = false;
+    int successor = 0;
+
+    if (hasPredecessor) {
+        DynamicBucket* before = Locate(predecessor, attempts);
+        hasSuccessor = (before->state & BUCKET_HAS_NEXT) != 0;
+        successor = before->nextKey;
+        before->nextKey = key;
+        before->state |= BUCKET_HAS_NEXT;
+        bucket.prevKey = predecessor;
+        bucket.state |= BUCKET_HAS_PREV;
+    }
+    else {
+        hasSuccessor = hasHead;
+        successor = headKey;
+        headKey = key;
+        hasHead = true;
+    }
+
+    if (hasSuccessor) {
+        DynamicBucket* after = Locate(successor, attempts);
+        after->prevKey = key;
+        after->state |= BUCKET_HAS_PREV;
+        bucket.nextKey = successor;
+        bucket.state |= BUCKET_HAS_NEXT;
+    }
+
+    PlaceIn(current, bucket);
+    occupiedBuckets++;
+    return true;
+}
+
+// Given:  key    - The key to be removed.
+//
+// Task:   To remove key from the table, unlinking it from the ordered list and leaving a tombstone in its bucket.
+//
+// Return: true or false        - True indicating key was removed, False indicating it was not present.
+bool DynamicHashTable::Erase(const int key) {
+    MigrateStep(MIGRATE_STEP);
+
+    int attempts;
+    DynamicBucket* bucket = Locate(key, attempts);
+    if (bucket == nullptr) {
+        return false;
+    }
+    const bool hasPrev = (bucket->state & BUCKET_HAS_PREV) != 0;
+    const bool hasNext = (bucket->state & BUCKET_HAS_NEXT) != 0;
+    const int prevKey = bucket->prevKey;
+    const int nextKey = bucket->nextKey;
+    bucket->state = BUCKET_TOMBSTONE;
+    occupiedBuckets--;
+
+    if (hasPrev) {
+        DynamicBucket* before = Locate(prevKey, attempts);
+        before->nextKey = nextKey;
+        before->state = static_cast<unsigned char>(hasNext ? (before->state | BUCKET_HAS_NEXT) : (before->state & ~BUCKET_HAS_NEXT));
+    }
+    else {
+        hasHead = hasNext;
+        headKey = nextKey;
+    }
+    if (hasNext) {
+        DynamicBucket* after = Locate(nextKey, attempts);
+        after->prevKey = prevKey;
+        after->state = static_cast<unsigned char>(hasPrev ? (after->state | BUCKET_HAS_PREV) : (after->state & ~BUCKET_HAS_PREV));
+    }
+
+    std::vector<int>::iterator fence = std::lower_bound(fences.begin(), fences.end(), key);
+    if (fence != fences.end() && *fence == key) {
+        fences.erase(fence);
+    }
+    return true;
+}
+
+// Given:  searchKey          - An integer representing the key wished to be searched for.
+//         result             - A Struct of Node which contains dummy information.
+//         searchAttempts     - An integer which currently contains dummy information.
+//
+// Task:   To search the table for searchKey without changing it, checking both arrays if a resize is under way.
+//
+// Return: true or false                    - True indicating the search value was found, False indicating it was not.
+//         result (via reference)           - A Struct of Node holding the key.
+//         searchAttempts (via reference)   - The number of buckets probed.
+bool DynamicHashTable::Search(const int searchKey, Node& result, int& searchAttempts) {
+    if (Locate(searchKey, searchAttempts) == nullptr) {
+        return false;
+    }
+    result = Node();
+    result.SetKeys(searchKey);
+    result.SetOccupancy(true);
+    return true;
+}
+
+// Given:  Nothing.
+//
+// Task:   To move another MIGRATE_STEP buckets if a resize is under way, for callers that mostly search and would
+//         otherwise leave every lookup checking both arrays until the next insert or erase.
+//
+// Return: true or false        - True indicating a resize is still under way, False indicating it is finished.
+bool DynamicHashTable::Maintain(void) {
+    MigrateStep(MIGRATE_STEP);
+    return migrating;
+}
+
+// Given:  key    - An integer which currently contains dummy information.
+//
+// Task:   To find the smallest key in the table.
+//
+// Return: true or false            - True indicating the table holds a key, False indicating it is empty.
+//         key (via reference)      - The smallest key.
+bool DynamicHashTable::GetFirst(int& key) {
+    key = headKey;
+    return hasHead;
+}
+
+// Given:  key        - A key in the table.
+//         nextKey    - An integer which currently contains dummy information.
+//
+// Task:   To follow the ordered list one step from key.
+//
+// Return: true or false                - True indicating a larger key exists, False indicating key is the largest or absent.
+//         nextKey (via reference)      - The next larger key.
+bool DynamicHashTable::GetNext(const int key, int& nextKey) {
+    int attempts;
+    DynamicBucket* bucket = Locate(key, attempts);
+    if (bucket == nullptr || !(bucket->state & BUCKET_HAS_NEXT)) {
+        return false;
+    }
+    nextKey = bucket->nextKey;
+    return true;
+}
+
+// Given:  Nothing.
+//
+// Task:   To print the keys in ascending order by following the ordered list from the smallest key.
+//
+// Return: Nothing.
+void DynamicHashTable::PrintList(void) {
+    int key;
+    for (bool more = GetFirst(key); more; more = GetNext(key, key)) {
+        std::cout << "Key: " << key << ", ModKey: " << key * 10 << std::endl;
+    }
+}
+
+// Given:  Nothing.
+//
+// Task:   To return the number of buckets in the current array.
+//
+// Return: The number of buckets new keys are inserted into.
+int DynamicHashTable::GetTableSize(void) {
+    return current.capacity;
+}
+
+// Given:  Nothing.
+//
+// Task:   To simply return occupiedBuckets.
+//
+// Return: occupiedBuckets        - The number of keys in the table.
+int DynamicHashTable::GetOccupiedBuckets(void) {
+    return occupiedBuckets;
+}
+
+// Given:  Nothing.
+//
+// Task:   To simply return migrating.
+//
+// Return: migrating        - True while a resize is still moving buckets.
+bool DynamicHashTable::IsMigrating(void) {
+    return migrating;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "globals.h"
+#include "node.h"
+
+#include <vector>
+
+constexpr int MIGRATE_STEP = 64;        // Old buckets moved to the new array by every insert, erase or Maintain call.
+constexpr int FENCE_SPACING = 32;       // Target number of list links between two consecutive fence keys.
+
+// One bucket of a DynamicHashTable. The ordered list links neighbours by key rather than by bucket, so a bucket can
+// move to another array during a resize without its neighbours having to be updated.
+struct DynamicBucket {
+    int key; // The stored key.
+    int prevKey; // The next smaller key in the table, valid when state has BUCKET_HAS_PREV.
+    int nextKey; // The next larger key in the table, valid when state has BUCKET_HAS_NEXT.
+    unsigned char state; // BUCKET_EMPTY, BUCKET_TOMBSTONE, or BUCKET_FULL with the link flags.
+};
+
+constexpr unsigned char BUCKET_EMPTY = 0;       // Never used: ends a probe sequence.
+constexpr unsigned char BUCKET_FULL = 1;        // Holds a key.
+constexpr unsigned char BUCKET_TOMBSTONE = 2;   // Held a key that was erased or moved: probing continues past it.
+constexpr unsigned char BUCKET_HAS_PREV = 4;    // prevKey is valid.
+constexpr unsigned char BUCKET_HAS_NEXT = 8;    // nextKey is valid.
+
+// One bucket array of a DynamicHashTable.
+struct DynamicArray {
+    std::unique_ptr<DynamicBucket[]> buckets; // The buckets, a power of two of them.
+    int capacity; // The number of buckets.
+    int shift; // 32 - log2(capacity), so the top bits of a 32-bit hash select the home bucket.
+    int used; // The number of buckets that are full or tombstones.
+};
+
+// A hash table that supports inserting and erasing any key at any time while keeping the ordered list of its keys.
+// When full and erased buckets pass 3/4 of the array a new array is allocated, and every later insert or erase moves
+// MIGRATE_STEP buckets into it, so there is never a pause to rehash the whole table. Until the move finishes, lookups
+// check both arrays. Search never changes the table; a caller that mostly searches can finish a move with Maintain.
+// A sorted array of fence keys, one every FENCE_SPACING links or so, lets an insert find its place in the ordered list
+// without walking it from the head.
+class DynamicHashTable {
+public:
+	DynamicHashTable();
+	DynamicHashTable(const int size);
+	~DynamicHashTable(void);
+	bool Insert(const int key);
+	bool Erase(const int key);
+	bool Search(const int searchKey, Node& result, int& searchAttempts);
+	bool Maintain(void);
+	bool GetFirst(int& key);
+	bool GetNext(const int key, int& nextKey);
+	void PrintList(void);
+	int GetTableSize(void);
+	int GetOccupiedBuckets(void);
+	bool IsMigrating(void);
+private:
+	void Allocate(DynamicArray& array, const int capacity);
+	int Home(const DynamicArray& array, const int key);
+	int FindIn(DynamicArray& array, const int key, int& searchAttempts);
+	DynamicBucket* Locate(const int key, int& searchAttempts);
+	void PlaceIn(DynamicArray& array, const DynamicBucket& bucket);
+	void MigrateStep(const int steps);
+	void GrowIfNeeded(void);
+	bool FindPredecessor(const int key, int& predecessor);
+	DynamicArray current; // The array new keys are inserted into.
+	DynamicArray previous; // The array being emptied into current while migrating.
+	bool migrating; // True while previous still holds buckets.
+	int migrateCursor; // The next bucket of previous to move.
+	int occupiedBuckets; // The number of keys in the table.
+	bool hasHead; // True when the table holds at least one key.
+	int headKey; // The smallest key in the table.
+	std::vector<int> fences; // Ascending keys in the table from which the ordered list may be walked.
+};
@@ -0,0 +1,244 @@
+#include "ExternalSort.h"
+#include "KeyFile.h"
+#include "Radix.h"
+
+#include <algorithm>
+#include <cstring>
+
+// The read side of one run during the merge.
+struct RunReader {
+    std::FILE* file; // The run being read.
+    std::unique_ptr<int[]> buffer; // The keys read from the run but not yet merged.
+    int count; // The number of keys in buffer.
+    int position; // The index in buffer of the run's current head.
+};
+
+// Given:  reader       - The run to read from.
+//         bufferKeys   - The number of keys the reader's buffer holds.
+//
+// Task:   To read the next block of the run into the reader's buffer.
+//
+// Return: true or false        - True indicating keys were read, False indicating the run is exhausted.
+static bool RefillRun(RunReader& reader, const int bufferKeys) {
+    reader.count = static_cast<int>(std::fread(reader.buffer.get(), sizeof(int), bufferKeys, reader.file));
+    reader.position = 0;
+    return reader.count > 0;
+}
+
+// Given:  chunkKeys    - The largest number of keys to hold in memory at once while creating runs.
+//         arena        - The arena chunks and sort buffers are taken from, which must outlive the sorter.
+//
+// Task:   To initialize a sorter with no runs.
+//
+// Return: Nothing.
+ExternalSorter::ExternalSorter(const int chunkKeys, Arena& arena) {
+    this->chunkKeys = std::max(chunkKeys, MIN_RUN_BUFFER_KEYS);
+    this->arena = &arena;
+    totalKeys = 0;
+}
+
+// Given:  Nothing.
+//
+// Task:   To destroy the sorter and delete its run files.
+//
+// Return: Nothing.
+ExternalSorter::~ExternalSorter(void) {
+    DiscardRuns();
+}
+
+// Given:  Nothing.
+//
+// Task:   To close, and so delete, every run file.
+//
+// Return: Nothing.
+void ExternalSorter::DiscardRuns(void) {
+    for (std::FILE* run : runs) {
+        std::fclose(run);
+    }
+    runs.clear();
+    totalKeys = 0;
+}
+
+// Given:  Nothing.
+//
+// Task:   To simply return the number of runs.
+//
+// Return: The number of sorted runs spilled so far.
+int ExternalSorter::GetRunCount(void) {
+    return static_cast<int>(runs.size());
+}
+
+// Given:  keys         - A chunk of unsorted keys.
+//         scratch      - A buffer of at least count integers for the sort.
+//         count        - The number of elements in the keys array.
+//
+// Task:   To sort the chunk and write it to a new temporary run file.
+//
+// Return: true or false        - True indicating the run was written, False indicating a file failure.
+bool ExternalSorter::SpillRun(int* keys, int* scratch, const int count) {
+    ParallelRadixSortKeys(keys, scratch, count, RADIX_DIGIT_BITS, SORT_THREADS, *arena);
+
+    std::FILE* run = std::tmpfile(); // Removed automatically when closed or when the program exits.
+    if (run == nullptr) {
+        return false;
+    }
+    if (std::fwrite(keys, sizeof(int), count, run) != static_cast<size_t>(count)) {
+        std::fclose(run);
+        return false;
+    }
+    runs.push_back(run);
+    totalKeys += count;
+    return true;
+}
+
+// Given:  inFile       - The mapped key file, text or binary.
+//
+// Task:   To cut the key file into chunks of at most chunkKeys keys, sort each and spill it as a run. Only one chunk and
+//         its sort scratch are held in memory, and the pages of the file are released once they have been consumed.
+//
+// Return: The number of keys across all runs, or -1 when the file is damaged or a run could not be written.
+int ExternalSorter::CreateRuns(MappedFile& inFile) {
+    DiscardRuns();
+
+    // Left uninitialized, every key is written before it is read. Handed back to the arena once the runs are written.
+    const ArenaMark mark = arena->Mark();
+    int* chunk = arena->Allocate<int>(chunkKeys);
+    int* scratch = arena->Allocate<int>(chunkKeys);
+    const int result = CreateRunsFrom(inFile, chunk, scratch);
+    arena->Rewind(mark);
+    return result;
+}
+
+// Given:  inFile       - The mapped key file, text or binary.
+//         chunk        - A buffer of chunkKeys integers for the keys of one run.
+//         scratch      - A buffer of chunkKeys integers for the sort.
+//
+// Task:   To cut the key file into chunks and spill each as a sorted run.
+//
+// Return: The number of keys across all runs, or -1 when the file is damaged or a run could not be written.
+int ExternalSorter::CreateRunsFrom(MappedFile& inFile, int* chunk, int* scratch) {
+    if (IsBinaryKeyFile(inFile.GetData(), inFile.GetSize())) {
+        KeyFileHeader header;
+        if (!ReadKeyFileHeader(inFile.GetData(), inFile.GetSize(), header)) {
+            return -1;
+        }
+        const int* keys = reinterpret_cast<const int*>(inFile.GetData() + sizeof(KeyFileHeader));
+        const int count = static_cast<int>(header.count);
+        for (int first = 0; first < count; first += chunkKeys) {
+            const int length = std::min(chunkKeys, count - first);
+            std::memcpy(chunk, &keys[first], sizeof(int) * length);
+            if (!SpillRun(chunk, scratch, length)) {
+                return -1;
+            }
+            inFile.Release(sizeof(KeyFileHeader) + sizeof(int) * first, sizeof(int) * length);
+        }
+        return totalKeys;
+    }
+
+    size_t position = 0;
+    while (position < inFile.GetSize()) {
+        const size_t start = position;
+        const int count = ParseKeysFrom(inFile.GetData(), inFile.GetSize(), position, chunk, chunkKeys);
+        if (count == 0) {
+            break;
+        }
+        if (!SpillRun(chunk, scratch, count)) {
+            return -1;
+        }
+        inFile.Release(start, position - start);
+    }
+    return totalKeys;
+}
+
+// Given:  sink         - The function receiving the merged keys.
+//
+// Task:   To merge every run into one ascending stream with a loser tree, handing the keys to sink in batches. Each run
+//         gets a read buffer sized so that all buffers together stay within about chunkKeys keys.
+//
+// Return: true or false        - True indicating every run was merged, False indicating a run could not be read.
+bool ExternalSorter::MergeRuns(const KeySink& sink) {
+
+    const int k = static_cast<int>(runs.size());
+    if (k == 0) {
+        return true;
+    }
+
+    const int bufferKeys = std::max(MIN_RUN_BUFFER_KEYS, chunkKeys / (k + 1));
+    std::vector<RunReader> readers(k);
+    std::unique_ptr<int[]> head(new int[k]); // The current smallest key of every run.
+    std::unique_ptr<bool[]> live(new bool[k]); // False once a run is exhausted.
+
+    for (int r = 0; r < k; r++) {
+        std::rewind(runs[r]);
+        readers[r].file = runs[r];
+        readers[r].buffer.reset(new int[bufferKeys]);
+        live[r] = RefillRun(readers[r], bufferKeys);
+        if (live[r]) {
+            head[r] = readers[r].buffer[readers[r].position++];
+        }
+    }
+
+    // Run a precedes run b when its head is smaller; exhausted runs never precede live ones.
+    auto Less = [&](const int a, const int b) {
+        if (!live[a]) {
+            return false;
+        }
+        if (!live[b]) {
+            return true;
+        }
+        return head[a] < head[b] || (head[a] == head[b] && a < b);
+    };
+
+    // Internal nodes 1 .. k-1 hold the loser of the match played there, leaf r sits at node k + r and tree[0] holds the
+    // overall winner. Replacing the winner then only replays the matches on the path from its leaf to the root.
+    std::unique_ptr<int[]> tree(new int[k]);
+    std::function<int(int)> Build = [&](const int node) {
+        if (node >= k) {
+            return node - k;
+        }
+        int left = Build(2 * node);
+        int right = Build(2 * node + 1);
+        if (Less(left, right)) {
+            tree[node] = right;
+            return left;
+        }
+        tree[node] = left;
+        return right;
+    };
+    tree[0] = (k == 1) ? 0 : Build(1);
+
+    std::unique_ptr<int[]> batch(new int[MERGE_BATCH_KEYS]);
+    int batchCount = 0;
+
+    while (live[tree[0]]) {
+        int winner = tree[0];
+        batch[batchCount++] = head[winner];
+        if (batchCount == MERGE_BATCH_KEYS) {
+            sink(batch.get(), batchCount);
+            batchCount = 0;
+        }
+
+        RunReader& reader = readers[winner];
+        if (reader.position == reader.count && !RefillRun(reader, bufferKeys)) {
+            live[winner] = false;
+            if (std::ferror(reader.file)) {
+                return false;
+            }
+        }
+        else {
+            head[winner] = reader.buffer[reader.position++];
+        }
+
+        for (int node = (winner + k) / 2; node >= 1; node /= 2) {
+            if (Less(tree[node], winner)) {
+                std::swap(tree[node], winner);
+            }
+        }
+        tree[0] = winner;
+    }
+
+    if (batchCount > 0) {
+        sink(batch.get(), batchCount);
+    }
+    return true;
+}
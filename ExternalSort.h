@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Arena.h"
+#include "globals.h"
+#include "Loader.h"
+
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+constexpr int MERGE_BATCH_KEYS = 4096;  // Keys handed to the sink per call during the merge.
+constexpr int MIN_RUN_BUFFER_KEYS = 1024;   // Smallest read buffer given to one run during the merge.
+
+// Called with each batch of keys the merge produces, in ascending order.
+typedef std::function<void(const int* keys, const int count)> KeySink;
+
+// Sorts a key file larger than memory: the file is cut into chunks of at most chunkKeys keys, each chunk is radix
+// sorted and spilled to a temporary run file, and the runs are then merged with a loser tree. The chunk and its sort
+// buffers come from an arena, so every run reuses the same memory.
+class ExternalSorter {
+public:
+	ExternalSorter(const int chunkKeys, Arena& arena);
+	~ExternalSorter(void);
+	ExternalSorter(const ExternalSorter&) = delete;
+	ExternalSorter& operator=(const ExternalSorter&) = delete;
+	int CreateRuns(MappedFile& inFile);
+	bool MergeRuns(const KeySink& sink);
+	int GetRunCount(void);
+	void DiscardRuns(void);
+private:
+	int CreateRunsFrom(MappedFile& inFile, int* chunk, int* scratch);
+	bool SpillRun(int* keys, int* scratch, const int count);
+	int chunkKeys; // The largest number of keys held in memory at once while creating runs.
+	int totalKeys; // The number of keys across all runs.
+	Arena* arena; // The arena chunks and sort buffers are taken from.
+	std::vector<std::FILE*> runs; // Temporary files each holding one sorted run, deleted when closed.
+};
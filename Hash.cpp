@@ -1,4 +1,21 @@
 #include "Hash.h"
+#include "KeyFile.h"
+#include "Snapshot.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PREFETCH_BUCKET(address) __builtin_prefetch(address)
+#elif defined(_MSC_VER)
+#include <xmmintrin.h>
+#define PREFETCH_BUCKET(address) _mm_prefetch(reinterpret_cast<const char*>(address), _MM_HINT_T0)
+#else
+#define PREFETCH_BUCKET(address) ((void)(address))
+#endif
 
 // Given:  Nothing.
 // 
@@ -7,9 +24,9 @@
 // Return: Nothing.
 HashTable::HashTable(void) {
     tableSize = 1;
-    table = AllocateArrayNode(tableSize);
-    headBucket = 0;
-    occupiedBuckets = 0;
+    hashPolicy = static_cast<HashPolicy>(HASH_POLICY);
+    orderCapacity = 1;
+    AllocateStorage(nullptr);
 }
 
 // Given:  size   - The essential number of buckets to hold all provided records.
@@ -18,12 +35,129 @@ HashTable::HashTable(void) {
 // 
 // Return: Nothing.
 HashTable::HashTable(const int size) {
-    tableSize = size * 3; // Multiplying by three to enlarge the table which will in return help reduce collisions.
-    table = AllocateArrayNode(tableSize); // increasing size of hash table to reduce collisions.
-    headBucket = 0;
-    occupiedBuckets = 0;
+    hashPolicy = static_cast<HashPolicy>(HASH_POLICY);
+    Allocate(size);
+}
+
+// Given:  value  - The least acceptable value.
+// 
+// Task:   To find the first prime from value by trial division, which runs once per Allocate.
+// 
+// Return: The smallest prime no less than value, and at least 2.
+static int NextPrime(const int value) {
+    for (int candidate = std::max(value, 2); ; candidate++) {
+        bool prime = true;
+        for (int divisor = 2; static_cast<long long>(divisor) * divisor <= candidate; divisor++) {
+            if (candidate % divisor == 0) {
+                prime = false;
+                break;
+            }
+        }
+        if (prime) {
+            return candidate;
+        }
+    }
+}
+
+// Given:  size   - The essential number of buckets to hold all provided records.
+// 
+// Task:   To discard the contents of the table and size it afresh for size records.
+// 
+// Return: Nothing.
+void HashTable::Allocate(const int size) {
+    tableSize = NextPrime(size * 3); // Multiplying by three to enlarge the table which will in return help reduce collisions.
+    orderCapacity = size;
+    AllocateStorage(nullptr);
     IncrementOccupiedBuckets();
+}
 
+// Given:  size   - The essential number of buckets to hold all provided records.
+//         arena  - The arena to take the table's arrays from, which must outlive the table's use of them.
+// 
+// Task:   To discard the contents of the table and size it afresh for size records in memory taken from arena.
+// 
+// Return: Nothing.
+void HashTable::Allocate(const int size, Arena& arena) {
+    tableSize = NextPrime(size * 3); // Multiplying by three to enlarge the table which will in return help reduce collisions.
+    orderCapacity = size;
+    AllocateStorage(&arena);
+    IncrementOccupiedBuckets();
+}
+
+// Given:  arena  - The arena to take the arrays from, nullptr to allocate them on the heap.
+// 
+// Task:   To allocate empty arrays for tableSize buckets and orderCapacity ordered keys, and to release any snapshot the
+//         table was using. From an arena, the Nodes and filter are only zeroed where the arena reuses memory, as a
+//         zeroed Node is an empty bucket, and the ordered view is left uninitialized as it is only read below orderCount.
+// 
+// Return: Nothing.
+void HashTable::AllocateStorage(Arena* arena) {
+    const int sampleCount = orderCapacity / ORDER_SAMPLE_RATE + 1;
+    if (arena == nullptr) {
+        tableStorage = AllocateArrayNode(tableSize); // increasing size of hash table to reduce collisions.
+        probeKeyStorage = AllocateArrayAtomic(tableSize, EMPTY_BUCKET);
+        orderKeyStorage.reset(new int[orderCapacity]); // Only read below orderCount, so left uninitialized.
+        orderBucketStorage.reset(new int[orderCapacity]);
+        sampleKeyStorage.reset(new int[sampleCount]);
+        bucketPositionStorage.reset(new int[tableSize]);
+        std::fill(bucketPositionStorage.get(), bucketPositionStorage.get() + tableSize, -1);
+        table = tableStorage.get();
+        probeKeys = probeKeyStorage.get();
+        orderKeys = orderKeyStorage.get();
+        orderBuckets = orderBucketStorage.get();
+        sampleKeys = sampleKeyStorage.get();
+        bucketPositions = bucketPositionStorage.get();
+        filter.Allocate(orderCapacity, LOOKUP_FILTER_BITS);
+    }
+    else {
+        tableStorage.reset();
+        probeKeyStorage.reset();
+        orderKeyStorage.reset();
+        orderBucketStorage.reset();
+        sampleKeyStorage.reset();
+        bucketPositionStorage.reset();
+        table = arena->AllocateZeroed<Node>(tableSize);
+        probeKeys = arena->Allocate<std::atomic<int>>(tableSize);
+        bucketPositions = arena->Allocate<int>(tableSize);
+        for (int i = 0; i < tableSize; i++) {
+            new (&probeKeys[i]) std::atomic<int>(EMPTY_BUCKET);
+            bucketPositions[i] = -1;
+        }
+        orderKeys = arena->Allocate<int>(orderCapacity);
+        orderBuckets = arena->Allocate<int>(orderCapacity);
+        sampleKeys = arena->Allocate<int>(sampleCount);
+        const int filterBlocks = BloomFilter::BlockCountFor(orderCapacity, LOOKUP_FILTER_BITS);
+        filter.Attach((filterBlocks > 0) ? arena->AllocateZeroed<BloomBlock>(filterBlocks) : nullptr, filterBlocks);
+    }
+    occupiedBuckets = 0;
+    orderCount = 0;
+    snapshotFile.Close();
+    HistogramCounts emptyChains;
+    emptyChains.counts[0] = static_cast<uint64_t>(tableSize); // Every bucket starts with no key calling it home.
+    chainLengths.Load(emptyChains);
+    insertProbes.Reset();
+    ResetSearchStats();
+}
+
+// Given:  Nothing.
+// 
+// Task:   To empty the table in place, keeping its arrays: every bucket, the filter, the ordered view and the statistics
+//         are returned to how AllocateStorage left them. No reader may be using the table meanwhile.
+// 
+// Return: Nothing.
+void HashTable::ClearContents(void) {
+    for (int i = 0; i < tableSize; i++) {
+        table[i] = Node();
+        probeKeys[i].store(EMPTY_BUCKET, std::memory_order_relaxed);
+        bucketPositions[i] = -1;
+    }
+    filter.Clear();
+    orderCount = 0;
+    HistogramCounts emptyChains;
+    emptyChains.counts[0] = static_cast<uint64_t>(tableSize); // Every bucket starts with no key calling it home.
+    chainLengths.Load(emptyChains);
+    insertProbes.Reset();
+    ResetSearchStats();
 }
 
 // Given:  Nothing.
@@ -51,13 +185,53 @@ std::unique_ptr<Node[]> HashTable::AllocateArrayNode(const int arraySize) {
     }
 }
 
+// Given:  arraySize    - The size of the array to be allocated.
+// 
+//         value        - The value every element starts with.
+// 
+// Task:   To dynamically allocate an array of atomic integers of size arraySize using a smart pointer.
+// 
+// Return: A std::unique_ptr to an array of atomic integers of size arraySize.
+std::unique_ptr<std::atomic<int>[]> HashTable::AllocateArrayAtomic(const int arraySize, const int value) {
+    try {
+        std::unique_ptr<std::atomic<int>[]> values(new std::atomic<int>[arraySize]);
+        for (int i = 0; i < arraySize; i++) {
+            values[i].store(value, std::memory_order_relaxed);
+        }
+        return values;
+    }
+    catch (const std::bad_alloc& e) {
+        // Handle failures
+        std::cerr << "Memory allocation failed: " << e.what() << std::endl;
+        return nullptr;
+    }
+}
+
 // Given:  Nothing.
 // 
-// Task:   To simply return headBucket.
+// Task:   To return the number of keys in the ordered view. Positions below it stay valid while another thread inserts.
+// 
+// Return: orderCount      - The number of keys in the ordered view.
+int HashTable::GetOrderedCount(void) {
+    return orderCount.load(std::memory_order_acquire);
+}
+
+// Given:  position  - A position below GetOrderedCount().
+// 
+// Task:   To simply return the key at position in the ordered view.
 // 
-// Return: tableSize       - The first occupied bucket in the hash table.
-int HashTable::GetHead(void) {
-    return headBucket;
+// Return: The position-th smallest key in the table.
+int HashTable::GetOrderedKey(const int position) {
+    return orderKeys[position];
+}
+
+// Given:  position  - A position below GetOrderedCount().
+// 
+// Task:   To simply return the bucket of the key at position in the ordered view.
+// 
+// Return: The bucket holding the position-th smallest key in the table.
+int HashTable::GetOrderedBucket(const int position) {
+    return orderBuckets[position];
 }
 
 // Given:  Nothing.
@@ -69,41 +243,72 @@ int HashTable::GetTableSize(void) {
     return tableSize;
 }
 
-// Given:  key  - Integer representing the key, which will be used to determine the hash value.
-//         i    - Integer representing the current probe iteration.
+// Given:  policy     - The HashPolicy to hash keys with.
 // 
-// Task:   To calculate the probe sequence index for the given key and probe iteration.
+// Task:   To change how keys are hashed, which is only possible while the table is empty.
 // 
-// Return: The calculated index from the probe sequence.
-int HashTable::Probe(const int key, const int i) {
-    return ( (HashFunction1(key)) + (i * HashFunction2(key)) + (i*i * HashFunction3(key)) ) % GetTableSize();
+// Return: true or false        - True indicating the policy is set, False indicating the table already holds keys or
+//                                the policy is unknown.
+bool HashTable::SetHashPolicy(const HashPolicy policy) {
+    if (GetOrderedCount() != 0 || policy < 0 || policy >= HASH_POLICY_COUNT) {
+        return false;
+    }
+    hashPolicy = policy;
+    return true;
 }
 
-// Given:  key  - Integer representing the key, which will be used to determine the hash value.
+// Given:  Nothing.
 // 
-// Task:   To calculate the hash value given the key and referring to the size of the table.
+// Task:   To simply return hashPolicy.
 // 
-// Return: The calculated hash value.
-int HashTable::HashFunction1(const int key) {
-    return key % GetTableSize();              // Page 296 Intro to Algorithms Textbook.
+// Return: hashPolicy      - How keys are hashed onto the table.
+HashPolicy HashTable::GetHashPolicy(void) {
+    return hashPolicy;
 }
 
-// Given:  key  - Integer representing the key, which will be used to determine the hash value.
+// Given:  value  - A 32-bit hash.
+//         range  - The number of buckets to map it onto.
 // 
-// Task:   To calculate the hash value given the key and referring to the size of the table.
+// Task:   To map value onto 0 .. range - 1 with Lemire's multiply-high reduction: a multiply and a shift in place of the
+//         division of value % range, taking the high bits of value, which the hashes mix best.
 // 
-// Return: The calculated hash value.
-int HashTable::HashFunction2(const int key) {
-    return 1 + ( key % (GetTableSize() -1) ); // Page 296 Intro to Algorithms Textbook.
+// Return: The bucket value falls in.
+static int FastRange(const uint32_t value, const int range) {
+    return static_cast<int>((static_cast<uint64_t>(value) * static_cast<uint64_t>(range)) >> 32);
 }
 
 // Given:  key  - Integer representing the key, which will be used to determine the hash value.
 // 
-// Task:   To calculate the hash value given the key and referring to the size of the table.
+// Task:   To hash the key once by the table's policy and derive its home bucket from the high half of the hash and its
+//         probe step from the low half. Negative keys hash as their two's complement bits.
 // 
-// Return: The calculated hash value.
-int HashTable::HashFunction3(const int key) {
-    return 1 + (key % (GetTableSize() - 3));  // Page 296 Intro to Algorithms Textbook.
+// Return: The probe sequence of key, at its home bucket.
+ProbeSequence HashTable::StartProbe(const int key) {
+    uint64_t hash = static_cast<uint32_t>(key);
+    if (hashPolicy == HASH_MIXER) {
+        hash ^= hash >> 33;
+        hash *= 0xFF51AFD7ED558CCDull;
+        hash ^= hash >> 33;
+        hash *= 0xC4CEB9FE1A85EC53ull;
+        hash ^= hash >> 33;
+    }
+    else {
+        hash *= 0x9E3779B97F4A7C15ull;
+    }
+    ProbeSequence probe;
+    probe.bucket = FastRange(static_cast<uint32_t>(hash >> 32), GetTableSize());
+    probe.step = 1 + FastRange(static_cast<uint32_t>(hash), GetTableSize() - 1);
+    return probe;
+}
+
+// Given:  probe  - The probe sequence of a key.
+// 
+// Task:   To move the probe sequence on to its next bucket, wrapping around the end of the table without a division.
+// 
+// Return: probe (via reference)        - The probe sequence at its next bucket.
+void HashTable::NextProbe(ProbeSequence& probe) {
+    const int untilEnd = GetTableSize() - probe.step;
+    probe.bucket = (probe.bucket >= untilEnd) ? probe.bucket - untilEnd : probe.bucket + probe.step;
 }
 
 // Given:  Nothing.
@@ -130,36 +335,55 @@ void HashTable::PrintTable(void) {
 
 // Given:  Nothing.
 // 
-// Task:   To print the retained sorted list in ascending order by using headBucket as the starting point.
+// Task:   To print the retained sorted list in ascending order by walking the ordered view front to back. The Node of
+//         a key a few positions ahead is prefetched, since the buckets themselves are scattered over the table.
 // 
 // Return: Nothing.
 void HashTable::PrintList(void) {
     // Prints the list in sorted ascended order.
-    for (nodePtr current = &table[GetHead()]; current != nullptr; current = current->GetNext()) {
-        std::cout << "Key: " << current->GetKey() << ", ModKey: " << current->GetModKey() << std::endl;
+    const int count = GetOrderedCount();
+    for (int position = 0; position < count; position++) {
+        if (position + SEARCH_BATCH_WIDTH < count) {
+            PREFETCH_BUCKET(&table[orderBuckets[position + SEARCH_BATCH_WIDTH]]);
+        }
+        const int bucket = orderBuckets[position];
+        std::cout << "Key: " << table[bucket].GetKey() << ", ModKey: " << table[bucket].GetModKey() << std::endl;
     }
 }
 
 // Given:  headNode            - A Struct of Node which is the next Node to be added to the hash table.
 //         prevBucket          - Integer representing the index of the Node inserted before headNode, here it is ignored, we just want to return that value for the HeadInsert function.
 // 
-// Task:   To insert the first Node into the hash table and to set headBucket.
+// Task:   To insert the first Node into the hash table and to start the ordered view with it.
 // 
 // Return: true or false                    - True indicating there is room to insert, False indicating there is no room.
 //         prevBucket (via reference)       - The index of the bucket that was just inserted into the hash table to setup for the next insert.
 bool HashTable::SetHead(Node headNode, int &prevBucket) {
     // Sets 
     int bucket;
-    for (int i = 0; i < GetTableSize(); i++) {
-        bucket = Probe(headNode.GetKey(), i);
+    if (headNode.GetKey() == EMPTY_BUCKET) {
+        return false; // The sentinel cannot be stored.
+    }
+    if (GetOrderedCount() >= orderCapacity) {
+        return false; // The ordered view is full.
+    }
+    ProbeSequence probe = StartProbe(headNode.GetKey());
+    for (int i = 0; i < GetTableSize(); i++, NextProbe(probe)) {
+        bucket = probe.bucket;
         if (i == 0) {
+            const int chain = table[bucket].GetGeneralBuckets();
             table[bucket].IncrementGeneralBuckets(); // NOT NEEDED, ONLY HERE TO MONITOR CHAINING AS WELL
+            chainLengths.Move(chain, chain + 1);
         }
-        if (table[bucket].GetOccupancy() == false) {
+        if (probeKeys[bucket].load(std::memory_order_relaxed) == EMPTY_BUCKET) {
             table[bucket].SetInitialAttempts(i + 1);
             table[bucket].SetKeys(headNode.GetKey());
             table[bucket].SetOccupancy(true);
-            headBucket = bucket;
+            filter.Insert(headNode.GetKey());
+            bucketPositions[bucket] = GetOrderedCount(); // Where AppendOrdered puts it, the ordered view having room.
+            probeKeys[bucket].store(headNode.GetKey(), std::memory_order_release); // Publish the filled bucket.
+            AppendOrdered(headNode.GetKey(), bucket);
+            insertProbes.Record(i + 1);
             prevBucket = bucket;
             return true;
         }
@@ -173,7 +397,25 @@ bool HashTable::SetHead(Node headNode, int &prevBucket) {
 // 
 // Return: occupiedBuckets        - The number of buckets that are occupied in the table.
 int HashTable::GetOccupiedBuckets(void) {
-    return occupiedBuckets;
+    return occupiedBuckets.load(std::memory_order_relaxed);
+}
+
+// Given:  Nothing.
+// 
+// Task:   To tell whether lookups are screened by a Bloom filter.
+// 
+// Return: true or false        - True indicating the table keeps a filter, False indicating it does not.
+bool HashTable::HasFilter(void) {
+    return filter.IsEnabled();
+}
+
+// Given:  Nothing.
+// 
+// Task:   To estimate how often a search for an absent key gets past the filter and has to probe.
+// 
+// Return: The estimated false positive rate of the filter, 1 when there is no filter.
+double HashTable::GetFilterFalsePositiveRate(void) {
+    return filter.EstimatedFalsePositiveRate();
 }
 
 // Given:  Nothing.
@@ -182,10 +424,10 @@ int HashTable::GetOccupiedBuckets(void) {
 // 
 // Return: Nothing.
 void HashTable::IncrementOccupiedBuckets(void) {
-    occupiedBuckets++;
+    occupiedBuckets.fetch_add(1, std::memory_order_relaxed);
 }
 
-// Given:  headNode               - A Struct of Node which is the next Node to be added to the hash table.
+// Given:  headNode               - A Struct of Node which is the next Node to be added to the hash table, not smaller than any key already in it.
 //         prevBucket             - Integer representing the index of the Node inserted before headNode.
 // 
 // Task:   To insert Nodes into the hashtable whilst retaining the order of the list.
@@ -194,18 +436,31 @@ void HashTable::IncrementOccupiedBuckets(void) {
 //         prevBucket (via reference)       - The index of the bucket that was just inserted into the hash table to setup for the next insert.
 bool HashTable::HeadInsert(Node headNode, int& prevBucket) {
     
+    if (headNode.GetKey() == EMPTY_BUCKET) {
+        return false; // The sentinel cannot be stored.
+    }
+    if (GetOrderedCount() >= orderCapacity) {
+        return false; // The ordered view is full.
+    }
     IncrementOccupiedBuckets();
     int bucket;
-    for (int i = 0; i < GetTableSize(); i++) {
-        bucket = Probe(headNode.GetKey(), i);
+    ProbeSequence probe = StartProbe(headNode.GetKey());
+    for (int i = 0; i < GetTableSize(); i++, NextProbe(probe)) {
+        bucket = probe.bucket;
         if (i == 0) {
+            const int chain = table[bucket].GetGeneralBuckets();
             table[bucket].IncrementGeneralBuckets(); // NOT NEEDED, ONLY HERE TO MONITOR CHAINING AS WELL
+            chainLengths.Move(chain, chain + 1);
         }
-        if (table[bucket].GetOccupancy() == false) {
+        if (probeKeys[bucket].load(std::memory_order_relaxed) == EMPTY_BUCKET) {
             table[bucket].SetInitialAttempts(i + 1);
             table[bucket].SetKeys(headNode.GetKey());
             table[bucket].SetOccupancy(true);
-            table[prevBucket].SetNext(&table[bucket]);
+            filter.Insert(headNode.GetKey());
+            bucketPositions[bucket] = GetOrderedCount(); // Where AppendOrdered puts it, the ordered view having room.
+            probeKeys[bucket].store(headNode.GetKey(), std::memory_order_release); // Publish the filled bucket.
+            AppendOrdered(headNode.GetKey(), bucket); // Then append it to the ordered view.
+            insertProbes.Record(i + 1);
             prevBucket = bucket;
             return true;
         }
@@ -213,6 +468,136 @@ bool HashTable::HeadInsert(Node headNode, int& prevBucket) {
     return false; // return false indicating there is no room!
 }
 
+// Given:  keys           - The keys to be loaded, in ascending order.
+//         count          - The number of elements in the keys array.
+//         threadCount    - The number of threads to load with, 0 for one per hardware thread.
+// 
+// Task:   To build an empty table from sorted keys in parallel. Every thread takes a contiguous slice of keys and claims
+//         buckets for them with an atomic compare and swap on probeKeys, so threads never take the same bucket. As the
+//         position of every key in the ordered view is its index in keys, each thread also fills its own slice of the
+//         ordered view. With several threads the home bucket counts kept for the chaining statistics are gathered in a
+//         temporary atomic array and folded into the Nodes once every key is placed. Copies of the sentinel, which
+//         sort first, are skipped as HeadInsert would refuse them; GetOrderedCount tells how many keys were loaded.
+//         Should a key still find no bucket, every bucket claimed so far is cleared again before returning.
+// 
+// Return: true or false        - True indicating every key but the sentinel was loaded, False indicating the table was
+//                                not empty or could not hold count keys, in which case it is left empty.
+bool HashTable::BulkLoad(const int* keys, int count, int threadCount) {
+    if (count <= 0 || GetOrderedCount() != 0 || count > orderCapacity) {
+        return false;
+    }
+    while (count > 0 && keys[0] == EMPTY_BUCKET) {
+        keys++;
+        count--;
+    }
+    if (count == 0) {
+        return true;
+    }
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    if (threadCount <= 1 || count < PARALLEL_LOAD_THRESHOLD) {
+        threadCount = 1;
+    }
+
+    std::unique_ptr<std::atomic<int>[]> homeHits;
+    if (threadCount > 1) {
+        homeHits = AllocateArrayAtomic(GetTableSize(), 0);
+    }
+    std::atomic<bool> failed(false);
+
+    // Claims a bucket for keys[first .. last - 1] and fills in their Nodes and ordered view positions.
+    auto LoadSlice = [&](const int first, const int last) {
+        HistogramCounts sliceProbes;
+        HistogramCounts sliceChains;
+        for (int position = first; position < last && !failed.load(std::memory_order_relaxed); position++) {
+            const int key = keys[position];
+            int bucket = -1;
+            if (key != EMPTY_BUCKET) {
+                ProbeSequence probe = StartProbe(key);
+                const int home = probe.bucket;
+                if (homeHits) {
+                    homeHits[home].fetch_add(1, std::memory_order_relaxed);
+                }
+                else {
+                    const int chain = table[home].GetGeneralBuckets();
+                    table[home].IncrementGeneralBuckets(); // NOT NEEDED, ONLY HERE TO MONITOR CHAINING AS WELL
+                    sliceChains.Move(chain, chain + 1);
+                }
+                for (int i = 0; i < GetTableSize(); i++, NextProbe(probe)) {
+                    int expected = EMPTY_BUCKET;
+                    const int candidate = probe.bucket;
+                    if (probeKeys[candidate].compare_exchange_strong(expected, key, std::memory_order_relaxed)) {
+                        bucket = candidate;
+                        table[bucket].SetInitialAttempts(i + 1);
+                        sliceProbes.Record(i + 1);
+                        break;
+                    }
+                }
+            }
+            if (bucket < 0) {
+                failed.store(true, std::memory_order_relaxed);
+                return;
+            }
+            table[bucket].SetKeys(key);
+            table[bucket].SetOccupancy(true);
+            filter.Insert(key);
+            orderKeys[position] = key;
+            orderBuckets[position] = bucket;
+            bucketPositions[bucket] = position;
+            if (position % ORDER_SAMPLE_RATE == 0) {
+                sampleKeys[position / ORDER_SAMPLE_RATE] = key;
+            }
+        }
+        insertProbes.Merge(sliceProbes); // Once per slice, so the threads do not contend on the counters.
+        chainLengths.Merge(sliceChains);
+    };
+
+    // Adds the home bucket counts of buckets first .. last - 1 to their Nodes.
+    auto FoldHomeHits = [&](const int first, const int last) {
+        HistogramCounts sliceChains;
+        for (int bucket = first; bucket < last; bucket++) {
+            const int hits = homeHits[bucket].load(std::memory_order_relaxed);
+            if (hits > 0) {
+                const int chain = table[bucket].GetGeneralBuckets();
+                for (int hit = 0; hit < hits; hit++) {
+                    table[bucket].IncrementGeneralBuckets();
+                }
+                sliceChains.Move(chain, chain + hits);
+            }
+        }
+        chainLengths.Merge(sliceChains);
+    };
+
+    // Runs work over [0, total) split into one contiguous slice per thread, the last slice on the calling thread.
+    auto RunSliced = [&](const int total, const std::function<void(int, int)>& work) {
+        const int sliceSize = (total + threadCount - 1) / threadCount;
+        std::vector<std::thread> workers;
+        workers.reserve(threadCount - 1);
+        for (int t = 0; t < threadCount - 1; t++) {
+            const int first = std::min(total, t * sliceSize);
+            workers.emplace_back(work, first, std::min(total, first + sliceSize));
+        }
+        work(std::min(total, (threadCount - 1) * sliceSize), total);
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    };
+
+    RunSliced(count, LoadSlice);
+    if (failed.load()) {
+        ClearContents();
+        return false;
+    }
+    if (homeHits) {
+        RunSliced(GetTableSize(), FoldHomeHits);
+    }
+
+    occupiedBuckets.fetch_add(count - 1, std::memory_order_relaxed); // As SetHead and then HeadInsert for the rest would.
+    orderCount.store(count, std::memory_order_release);
+    return true;
+}
+
 // Given:  searchKey          - An integer representing the key wished to be searched for.
 //         result             - A Struct of Node which contains dummy information.
 //         searchAttempts     - An integer representing the number of attempts to complete the search which currently contains dummy information.
@@ -224,22 +609,322 @@ bool HashTable::HeadInsert(Node headNode, int& prevBucket) {
 //         searchAttempts (via reference)   - An integer representing the amount of times needed to probe 
 bool HashTable::Search(const int searchKey, Node& result, int& searchAttempts) {
 
+    // Only the Node fields that never change after the bucket is published are copied, so this is safe while
+    // another thread inserts.
+    int bucket = FindBucket(searchKey, searchAttempts);
+    if (COLLECT_SEARCH_STATS) {
+        (bucket < 0 ? missProbes : hitProbes).Record(searchAttempts);
+    }
+    if (bucket < 0) {
+        return false; // return false indicating that search value is not present!
+    }
+    result = Node();
+    result.SetKeys(table[bucket].GetKey());
+    result.SetInitialAttempts(table[bucket].GetAttempts());
+    result.SetOccupancy(true);
+    return true;
+}
+
+// Given:  searchKey          - An integer representing the key wished to be searched for.
+//         searchAttempts     - An integer representing the number of attempts to complete the search which currently contains dummy information.
+// 
+// Task:   To find the bucket holding searchKey by probing the packed probeKeys array only, unless the filter already
+//         rules the key out.
+// 
+// Return: The bucket holding searchKey, or -1 when it is not present.
+//         searchAttempts (via reference)   - An integer representing the amount of times needed to probe.
+int HashTable::FindBucket(const int searchKey, int& searchAttempts) {
     int bucket;
+    int stored;
     searchAttempts = 0;
-    for (int i = 0; i < GetTableSize(); i++) {
-        bucket = Probe(searchKey, i);
+    if (searchKey == EMPTY_BUCKET || !filter.MayContain(searchKey)) {
+        return -1;
+    }
+    ProbeSequence probe = StartProbe(searchKey);
+    for (int i = 0; i < GetTableSize(); i++, NextProbe(probe)) {
+        bucket = probe.bucket;
         searchAttempts++;
-        if (table[bucket].GetOccupancy() == false) {
-            return false; // return false indicating that search value is not present!
+        stored = probeKeys[bucket].load(std::memory_order_acquire);
+        if (stored == EMPTY_BUCKET) {
+            return -1;
         }
-        else {
-            if (searchKey == table[bucket].GetKey()) {
-                result = table[bucket];
-                return true;
+        if (searchKey == stored) {
+            return bucket;
+        }
+    }
+    return -1;
+}
+
+// Given:  searchKeys         - An array of keys wished to be searched for.
+//         count              - The number of elements in the searchKeys array.
+//         results            - An array of count SearchResults which currently contain dummy information.
+// 
+// Task:   To search for a batch of keys while hiding memory latency. Up to SEARCH_BATCH_WIDTH lookups are in flight:
+//         each step of a lookup prefetches its next bucket and moves on to the other lookups, so by the time it is
+//         visited again the bucket is usually in cache. A finished lookup hands its place to the next key. With a
+//         filter, the first step of every lookup tests the key's prefetched filter block instead of a bucket.
+// 
+// Return: results (via reference)          - results[j] describes the lookup of searchKeys[j].
+void HashTable::SearchBatch(const int* searchKeys, const int count, SearchResult* results) {
+
+    // The state of one in-flight lookup.
+    struct Lookup {
+        int index; // The index in searchKeys of the key being looked up, -1 when the place is idle.
+        int attempt; // The probe iteration whose bucket is being waited for, -1 while waiting for the filter block.
+        ProbeSequence probe; // The key's probe sequence, at the bucket of that probe iteration.
+    };
+
+    Lookup inFlight[SEARCH_BATCH_WIDTH];
+    int nextKey = 0;
+    int active = 0;
+
+    // Gives the place to the next key, if any, and prefetches its filter block, or its home bucket when there is no
+    // filter. The sentinel is never stored, so looking it up finishes at once.
+    auto StartLookup = [&](Lookup& lookup) {
+        while (nextKey < count && searchKeys[nextKey] == EMPTY_BUCKET) {
+            results[nextKey] = { -1, 0, false };
+            nextKey++;
+        }
+        if (nextKey < count) {
+            lookup.index = nextKey;
+            if (filter.IsEnabled()) {
+                lookup.attempt = -1;
+                PREFETCH_BUCKET(filter.GetBlock(searchKeys[nextKey]));
+            }
+            else {
+                lookup.attempt = 0;
+                lookup.probe = StartProbe(searchKeys[nextKey]);
+                PREFETCH_BUCKET(&probeKeys[lookup.probe.bucket]);
+            }
+            nextKey++;
+            return true;
+        }
+        lookup.index = -1;
+        return false;
+    };
+
+    for (int w = 0; w < SEARCH_BATCH_WIDTH; w++) {
+        if (StartLookup(inFlight[w])) {
+            active++;
+        }
+    }
+
+    while (active > 0) {
+        for (int w = 0; w < SEARCH_BATCH_WIDTH; w++) {
+            Lookup& lookup = inFlight[w];
+            if (lookup.index < 0) {
+                continue;
+            }
+
+            const int key = searchKeys[lookup.index];
+            bool done = true;
+
+            if (lookup.attempt < 0) {
+                if (filter.MayContain(key)) {
+                    lookup.attempt = 0;
+                    lookup.probe = StartProbe(key);
+                    PREFETCH_BUCKET(&probeKeys[lookup.probe.bucket]);
+                    continue;
+                }
+                results[lookup.index] = { -1, 0, false };
+                if (!StartLookup(lookup)) {
+                    active--;
+                }
+                continue;
+            }
+
+            const int stored = probeKeys[lookup.probe.bucket].load(std::memory_order_acquire);
+            if (stored == key) {
+                results[lookup.index] = { lookup.probe.bucket, lookup.attempt + 1, true };
+            }
+            else if (stored == EMPTY_BUCKET || lookup.attempt + 1 >= GetTableSize()) {
+                results[lookup.index] = { -1, lookup.attempt + 1, false };
+            }
+            else {
+                lookup.attempt++;
+                NextProbe(lookup.probe);
+                PREFETCH_BUCKET(&probeKeys[lookup.probe.bucket]);
+                done = false;
+            }
+
+            if (done && !StartLookup(lookup)) {
+                active--;
             }
         }
     }
-    return false;
+
+    if (COLLECT_SEARCH_STATS) {
+        HistogramCounts batchHits;
+        HistogramCounts batchMisses;
+        for (int j = 0; j < count; j++) {
+            (results[j].found ? batchHits : batchMisses).Record(results[j].searchAttempts);
+        }
+        hitProbes.Merge(batchHits);
+        missProbes.Merge(batchMisses);
+    }
+}
+
+// Given:  key        - The key just published to probeKeys, not smaller than any key already in the ordered view, which
+//                      may already hold copies of it.
+//         bucket     - The bucket holding key.
+// 
+// Task:   To append the key to the ordered view, sampling every ORDER_SAMPLE_RATE-th one into the sparse order index.
+//         Everything is written before orderCount is published, so readers never see a half written position.
+// 
+// Return: true or false        - True indicating the key was appended, False indicating the ordered view is full.
+bool HashTable::AppendOrdered(const int key, const int bucket) {
+    const int count = orderCount.load(std::memory_order_relaxed);
+    if (count >= orderCapacity) {
+        return false;
+    }
+    orderKeys[count] = key;
+    orderBuckets[count] = bucket;
+    if (count % ORDER_SAMPLE_RATE == 0) {
+        sampleKeys[count / ORDER_SAMPLE_RATE] = key;
+    }
+    orderCount.store(count + 1, std::memory_order_release);
+    return true;
+}
+
+// Given:  key        - The key whose place in the ordered view is wanted.
+//         count      - The number of positions of the ordered view to consider.
+// 
+// Task:   To binary search the sparse order index for the last sample smaller than key.
+// 
+// Return: The position of that sample in the ordered view, 0 when no sampled key is smaller than key.
+int HashTable::FindSampleBelow(const int key, const int count) {
+    int low = 0;
+    int high = (count + ORDER_SAMPLE_RATE - 1) / ORDER_SAMPLE_RATE;
+    while (low < high) {
+        int middle = low + (high - low) / 2;
+        if (sampleKeys[middle] < key) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+    return (low == 0) ? 0 : (low - 1) * ORDER_SAMPLE_RATE;
+}
+
+// Given:  key        - The key whose place in the ordered view is wanted.
+//         count      - The number of positions of the ordered view to consider.
+// 
+// Task:   To binary search the sparse order index for the first sample greater than key, so that the block before it
+//         holds the last copy of key when key repeats.
+// 
+// Return: The position in the ordered view of the sample before that one, 0 when every sampled key is greater than key.
+int HashTable::FindSampleNotAbove(const int key, const int count) {
+    int low = 0;
+    int high = (count + ORDER_SAMPLE_RATE - 1) / ORDER_SAMPLE_RATE;
+    while (low < high) {
+        int middle = low + (high - low) / 2;
+        if (sampleKeys[middle] <= key) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+    return (low == 0) ? 0 : (low - 1) * ORDER_SAMPLE_RATE;
+}
+
+// Given:  key        - The key whose place in the ordered view is wanted.
+//         count      - The number of positions of the ordered view to consider.
+// 
+// Task:   To find key through the hash table and read its position from the bucket holding it. A key that is absent,
+//         or published to probeKeys but not yet below count, has no position.
+// 
+// Return: The position of one copy of key in the ordered view, or -1 when there is none below count.
+int HashTable::FindOrderedPosition(const int key, const int count) {
+    int searchAttempts;
+    const int bucket = FindBucket(key, searchAttempts);
+    if (bucket < 0) {
+        return -1;
+    }
+    const int position = bucketPositions[bucket];
+    return (position < count) ? position : -1;
+}
+
+// Given:  key        - The key wished to be bounded.
+// 
+// Task:   To find the smallest key in the table not less than key. A key in the table is found with a hash hit, which
+//         gives the answer at once unless a copy of key sits before the one hit. Otherwise the sparse order index
+//         narrows the search to one block of ORDER_SAMPLE_RATE contiguous keys, which is then scanned sequentially.
+// 
+// Return: The position of that key in the ordered view, or -1 when every key is smaller than key.
+int HashTable::LowerBound(const int key) {
+    const int count = GetOrderedCount();
+    const int hit = FindOrderedPosition(key, count);
+    if (hit >= 0 && (hit == 0 || orderKeys[hit - 1] != key)) {
+        return hit;
+    }
+    int position = FindSampleBelow(key, count);
+    while (position < count && orderKeys[position] < key) {
+        position++;
+    }
+    return (position < count) ? position : -1;
+}
+
+// Given:  key        - The key wished to be bounded.
+// 
+// Task:   To find the smallest key in the table greater than key, past every copy of key. A key in the table is found
+//         with a hash hit, which gives the answer at once unless a copy of key sits after the one hit. Otherwise the
+//         sparse order index narrows the search to the block holding the last copy, which is then scanned sequentially.
+// 
+// Return: The position of that key in the ordered view, or -1 when no key is greater than key.
+int HashTable::UpperBound(const int key) {
+    const int count = GetOrderedCount();
+    const int hit = FindOrderedPosition(key, count);
+    if (hit >= 0 && (hit + 1 == count || orderKeys[hit + 1] != key)) {
+        return (hit + 1 < count) ? hit + 1 : -1;
+    }
+    int position = FindSampleNotAbove(key, count);
+    while (position < count && orderKeys[position] <= key) {
+        position++;
+    }
+    return (position < count) ? position : -1;
+}
+
+// Given:  key        - The key whose successor is wanted, which need not be in the table.
+// 
+// Task:   To find the next larger key than key.
+// 
+// Return: The position of the successor in the ordered view, or -1 when key is not smaller than every key in the table.
+int HashTable::Successor(const int key) {
+    return UpperBound(key);
+}
+
+// Given:  key        - The key whose predecessor is wanted, which need not be in the table.
+// 
+// Task:   To find the next smaller key than key, which sits just before LowerBound(key) in the ordered view.
+// 
+// Return: The position of the predecessor in the ordered view, or -1 when no key in the table is smaller than key.
+int HashTable::Predecessor(const int key) {
+    const int position = LowerBound(key);
+    return (position == -1) ? GetOrderedCount() - 1 : position - 1;
+}
+
+// Given:  low        - The smallest key of the range.
+//         high       - The largest key of the range.
+//         buckets    - An array which receives the buckets of the keys found.
+//         capacity   - The number of elements the buckets array can hold.
+// 
+// Task:   To list the keys in [low, high] in ascending order, reading the ordered view sequentially from LowerBound(low).
+// 
+// Return: The number of buckets written, at most capacity.
+//         buckets (via reference)      - The buckets of the keys in the range in ascending order of key.
+int HashTable::RangeScan(const int low, const int high, int* buckets, const int capacity) {
+    const int first = LowerBound(low);
+    if (first == -1) {
+        return 0;
+    }
+    const int count = GetOrderedCount();
+    int written = 0;
+    for (int position = first; position < count && written < capacity && orderKeys[position] <= high; position++) {
+        buckets[written++] = orderBuckets[position];
+    }
+    return written;
 }
 
 // Given:  Nothing
@@ -248,13 +933,7 @@ bool HashTable::Search(const int searchKey, Node& result, int& searchAttempts) {
 // 
 // Return: listedBuckets      - An integer representing the number of items in the longest list if chaining was used.
 int HashTable::PopularBucketChain(void) {
-    int longestList = table[0].GetGeneralBuckets();
-    for (int i = 0; i < GetTableSize(); i++) {
-        if (table[i].GetGeneralBuckets() > longestList) {
-            longestList = table[i].GetGeneralBuckets();
-        }
-    }
-    return longestList;
+    return chainLengths.GetMax();
 }
 
 // Given:  Nothing.
@@ -263,20 +942,341 @@ int HashTable::PopularBucketChain(void) {
 // 
 // Return: onePlusBuckets      - An integer representing the number of buckets that would have one or more items if chaining was used.
 int HashTable::CalculateOnePlusBuckets(void) {
-    int onePlusBuckets = 0;
-    for (int i = 0; i < GetTableSize(); i++) {
-        if (table[i].GetGeneralBuckets() >= 1) {
-            onePlusBuckets++;
+    return GetTableSize() - static_cast<int>(chainLengths.GetCount(0));
+}
+
+// Given:  Nothing.
+// 
+// Task:   To work out how full the table is.
+// 
+// Return: The fraction of buckets holding a key.
+double HashTable::GetLoadFactor(void) {
+    return static_cast<double>(GetOrderedCount()) / GetTableSize();
+}
+
+// Given:  Nothing.
+// 
+// Task:   To find how far from its home bucket the furthest key was placed.
+// 
+// Return: The most probe iterations any insert made past the key's home bucket, 0 for an empty table.
+int HashTable::GetMaxDisplacement(void) {
+    const int longest = insertProbes.GetMax();
+    return (longest > 0) ? longest - 1 : 0;
+}
+
+// Given:  Nothing.
+// 
+// Task:   To simply return the histogram of the buckets probed by every insert.
+// 
+// Return: insertProbes     - Bin b counts the inserts that probed b buckets.
+Histogram& HashTable::GetInsertProbes(void) {
+    return insertProbes;
+}
+
+// Given:  Nothing.
+// 
+// Task:   To simply return the histogram of the buckets probed by every search that found its key.
+// 
+// Return: hitProbes        - Bin b counts the successful searches that probed b buckets.
+Histogram& HashTable::GetHitProbes(void) {
+    return hitProbes;
+}
+
+// Given:  Nothing.
+// 
+// Task:   To simply return the histogram of the buckets probed by every search that did not find its key.
+// 
+// Return: missProbes       - Bin b counts the failed searches that probed b buckets, bin 0 those the filter answered.
+Histogram& HashTable::GetMissProbes(void) {
+    return missProbes;
+}
+
+// Given:  Nothing.
+// 
+// Task:   To simply return the histogram of the keys that had every bucket as their home.
+// 
+// Return: chainLengths     - Bin b counts the buckets whose chain would hold b items if chaining was used.
+Histogram& HashTable::GetChainLengths(void) {
+    return chainLengths;
+}
+
+// Given:  Nothing.
+// 
+// Task:   To simply return the timers of the phases that built the table, for the builder to time them with.
+// 
+// Return: phases           - The phase timers of the table.
+PhaseTimers& HashTable::GetPhaseTimers(void) {
+    return phases;
+}
+
+// Given:  Nothing.
+// 
+// Task:   To forget every search counted so far, e.g. once a warm up is over.
+// 
+// Return: Nothing.
+void HashTable::ResetSearchStats(void) {
+    hitProbes.Reset();
+    missProbes.Reset();
+}
+
+// Given:  histogram  - The histogram to print.
+//         out        - The stream to print to.
+// 
+// Task:   To print every non-empty bin of a histogram on a line of its own, with its share of the total.
+// 
+// Return: Nothing.
+static void DumpHistogram(Histogram& histogram, std::ostream& out) {
+    const uint64_t total = histogram.GetTotal();
+    for (int b = 0; b < STATS_HISTOGRAM_BINS; b++) {
+        const uint64_t count = histogram.GetCount(b);
+        if (count == 0) {
+            continue;
         }
+        out << "		" << b << ((b == STATS_HISTOGRAM_BINS - 1) ? " or more: " : ": ") << count
+            << " (" << 100.0 * count / total << "%)" << std::endl;
+    }
+}
+
+// Given:  out        - The stream to print to.
+// 
+// Task:   To print every statistic the table keeps, reading each counter once rather than scanning the table.
+// 
+// Return: Nothing.
+void HashTable::DumpStats(std::ostream& out) {
+    out << "Number of occupied buckets: " << GetOccupiedBuckets() << std::endl;
+    out << "Number of unoccupied buckets: " << GetTableSize() - GetOccupiedBuckets() << std::endl;
+    out << "	" << GetOccupiedBuckets() << " out of the " << GetTableSize() << " buckets contains relevant data." << std::endl;
+    out << "	Load factor: " << GetLoadFactor() << std::endl;
+
+    out << std::endl << "Monitoring of Chaining (I did not go with this implementation): " << std::endl;
+    out << "	Longest List of items if chaining was used: " << PopularBucketChain() << std::endl;
+    out << "	Number of buckets with 1 or more items if chaining was used: " << CalculateOnePlusBuckets() << std::endl;
+    out << "	Number of buckets by items if chaining was used:" << std::endl;
+    DumpHistogram(chainLengths, out);
+
+    out << std::endl << "Monitoring of Open Addressing (I went with this implementation): " << std::endl;
+    out << "	Keys hashed by: " << ((hashPolicy == HASH_MIXER) ? "murmur finalizer" : "multiply-shift") << std::endl;
+    out << "	Longest probe sequence of an insert: " << insertProbes.GetMax() << std::endl;
+    out << "	Maximum displacement from the home bucket: " << GetMaxDisplacement() << std::endl;
+    out << "	Average buckets probed per insert: " << insertProbes.GetMean() << std::endl;
+    out << "	Inserts by buckets probed:" << std::endl;
+    DumpHistogram(insertProbes, out);
+    if (COLLECT_SEARCH_STATS) {
+        out << "	Searches that found their key: " << hitProbes.GetTotal() << ", average buckets probed: "
+            << hitProbes.GetMean() << ", most: " << hitProbes.GetMax() << std::endl;
+        DumpHistogram(hitProbes, out);
+        out << "	Searches that did not: " << missProbes.GetTotal() << ", average buckets probed: "
+            << missProbes.GetMean() << ", most: " << missProbes.GetMax() << std::endl;
+        DumpHistogram(missProbes, out);
+    }
+
+    if (HasFilter()) {
+        out << std::endl << "Bloom filter checked before probing: " << std::endl;
+        out << "	Estimated false positive rate: " << GetFilterFalsePositiveRate() * 100.0 << "%" << std::endl;
+    }
+
+    out << std::endl << "Time spent building the table: " << std::endl;
+    for (int phase = 0; phase < PHASE_COUNT; phase++) {
+        if (phases.GetSeconds(phase) == 0.0) {
+            continue;
+        }
+        out << "	" << PhaseTimers::GetPhaseName(phase) << ": " << phases.GetSeconds(phase) * 1000.0 << " ms";
+        if (phases.HasHardwareCounters()) {
+            for (int event = 0; event < HW_EVENT_COUNT; event++) {
+                out << ", " << phases.GetEvents(phase, event) << " " << HardwareCounters::GetEventName(event);
+            }
+        }
+        out << std::endl;
     }
-    return onePlusBuckets;
 }
 
 // Given:  Nothing.
 // 
 // Task:   To return the dynamically allocated array of Nodes.
 // 
-// Return: table            - The dynamically allocated array of Nodes which acts as our Hash Table.
-std::unique_ptr<Node[]>& HashTable::GetTable(void) {
+// Return: table            - The array of Nodes which acts as our Hash Table.
+Node* HashTable::GetTable(void) {
     return table;
 }
+
+
+static_assert(sizeof(std::atomic<int>) == sizeof(int), "Snapshots store the probe keys as plain 32-bit words.");
+
+// Given:  offset     - The offset of the end of the previous section.
+// 
+// Task:   To round the offset up to the start of the next section.
+// 
+// Return: The offset rounded up to a multiple of SNAPSHOT_ALIGNMENT.
+static uint64_t AlignSection(const uint64_t offset) {
+    return (offset + SNAPSHOT_ALIGNMENT - 1) / SNAPSHOT_ALIGNMENT * SNAPSHOT_ALIGNMENT;
+}
+
+// Given:  outFile    - The snapshot being written, positioned at the end of the previous section.
+//         data       - The section's bytes.
+//         length     - The number of bytes in data.
+//         offset     - The offset of the end of the previous section.
+// 
+// Task:   To pad the file to the next section boundary and write the section there.
+// 
+// Return: offset (via reference)       - The offset of the end of this section.
+static void WriteSection(std::ofstream& outFile, const void* data, const uint64_t length, uint64_t& offset) {
+    static const char padding[SNAPSHOT_ALIGNMENT] = {};
+    const uint64_t start = AlignSection(offset);
+    outFile.write(padding, static_cast<std::streamsize>(start - offset));
+    outFile.write(static_cast<const char*>(data), static_cast<std::streamsize>(length));
+    offset = start + length;
+}
+
+// Given:  outFile    - The snapshot being written, positioned at the end of the previous section.
+//         data       - The section's bytes, of which only the first used are meaningful.
+//         used       - The number of bytes of data to copy.
+//         length     - The length of the section, at least used.
+//         offset     - The offset of the end of the previous section.
+// 
+// Task:   To write a section of which only a prefix is in use, zero filling the rest rather than copying whatever the
+//         memory past it happens to hold, so the same table always saves to the same bytes.
+// 
+// Return: offset (via reference)       - The offset of the end of this section.
+static void WritePartialSection(std::ofstream& outFile, const void* data, const uint64_t used, const uint64_t length,
+                                uint64_t& offset) {
+    static const char zeros[4096] = {};
+    WriteSection(outFile, data, used, offset);
+    for (uint64_t left = length - used; left > 0; ) {
+        const uint64_t chunk = std::min<uint64_t>(left, sizeof(zeros));
+        outFile.write(zeros, static_cast<std::streamsize>(chunk));
+        left -= chunk;
+    }
+    offset += length - used;
+}
+
+// Given:  path       - The path of the snapshot file to write.
+// 
+// Task:   To save the whole table as a snapshot: a header followed by every array exactly as it lies in memory. No
+//         writer may insert while the snapshot is being saved.
+// 
+// Return: true or false        - True indicating the snapshot was written, False indicating a write failure.
+bool HashTable::SaveSnapshot(const char* path) {
+    SnapshotHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = SNAPSHOT_VERSION;
+    header.nodeSize = sizeof(Node);
+    header.tableSize = tableSize;
+    header.orderCapacity = orderCapacity;
+    header.orderCount = GetOrderedCount();
+    header.occupiedBuckets = GetOccupiedBuckets();
+    header.filterBlocks = filter.GetBlockCount();
+    header.hashPolicy = hashPolicy;
+
+    const uint64_t sampleCount = orderCapacity / ORDER_SAMPLE_RATE + 1;
+    uint64_t offset = sizeof(SnapshotHeader);
+    header.tableOffset = offset = AlignSection(offset);
+    offset += sizeof(Node) * static_cast<uint64_t>(tableSize);
+    header.probeKeysOffset = offset = AlignSection(offset);
+    offset += sizeof(int) * static_cast<uint64_t>(tableSize);
+    header.orderKeysOffset = offset = AlignSection(offset);
+    offset += sizeof(int) * static_cast<uint64_t>(orderCapacity);
+    header.orderBucketsOffset = offset = AlignSection(offset);
+    offset += sizeof(int) * static_cast<uint64_t>(orderCapacity);
+    header.sampleKeysOffset = offset = AlignSection(offset);
+    offset += sizeof(int) * sampleCount;
+    header.bucketPositionsOffset = offset = AlignSection(offset);
+    offset += sizeof(int) * static_cast<uint64_t>(tableSize);
+    header.filterOffset = offset = AlignSection(offset);
+    offset += sizeof(BloomBlock) * static_cast<uint64_t>(header.filterBlocks);
+    header.statsOffset = offset = AlignSection(offset);
+    offset += 2 * sizeof(HistogramCounts);
+    header.fileSize = offset;
+    header.checksum = KeyFileChecksum(reinterpret_cast<const int*>(&header), offsetof(SnapshotHeader, checksum) / sizeof(int));
+
+    std::ofstream outFile(path, std::ios::binary | std::ios::trunc);
+    if (outFile.fail()) {
+        return false;
+    }
+    offset = 0;
+    WriteSection(outFile, &header, sizeof(header), offset);
+    WriteSection(outFile, table, sizeof(Node) * static_cast<uint64_t>(tableSize), offset);
+    WriteSection(outFile, probeKeys, sizeof(int) * static_cast<uint64_t>(tableSize), offset);
+    // The ordered view is only written below orderCount, and the arrays may come uninitialized from an arena.
+    const uint64_t usedBytes = sizeof(int) * static_cast<uint64_t>(header.orderCount);
+    const uint64_t orderBytes = sizeof(int) * static_cast<uint64_t>(orderCapacity);
+    const uint64_t usedSamples = static_cast<uint64_t>(header.orderCount + ORDER_SAMPLE_RATE - 1) / ORDER_SAMPLE_RATE;
+    WritePartialSection(outFile, orderKeys, usedBytes, orderBytes, offset);
+    WritePartialSection(outFile, orderBuckets, usedBytes, orderBytes, offset);
+    WritePartialSection(outFile, sampleKeys, sizeof(int) * usedSamples, sizeof(int) * sampleCount, offset);
+    WriteSection(outFile, bucketPositions, sizeof(int) * static_cast<uint64_t>(tableSize), offset);
+    WriteSection(outFile, filter.GetBlocks(), sizeof(BloomBlock) * static_cast<uint64_t>(header.filterBlocks), offset);
+    const HistogramCounts stats[2] = { insertProbes.Read(), chainLengths.Read() };
+    WriteSection(outFile, stats, sizeof(stats), offset);
+    outFile.close();
+    return !outFile.fail() && offset == header.fileSize;
+}
+
+// Given:  path       - The path of a snapshot written by SaveSnapshot.
+// 
+// Task:   To replace the table with the one in the snapshot. The file is mapped copy-on-write and its arrays are used
+//         where they lie, so opening costs only the header check and pages are read as lookups touch them. Only the
+//         header is validated; the arrays are trusted as written. No reader may be using the table meanwhile.
+// 
+// Return: true or false        - True indicating the table now holds the snapshot, False indicating a missing, damaged
+//                                or foreign file, in which case the table is left as it was.
+bool HashTable::LoadSnapshot(const char* path) {
+    if (snapshotFile.GetData() != nullptr) {
+        return false; // Already viewing a snapshot; Allocate first.
+    }
+    if (!snapshotFile.Open(path) || snapshotFile.GetSize() < sizeof(SnapshotHeader)) {
+        snapshotFile.Close();
+        return false;
+    }
+
+    SnapshotHeader header;
+    std::memcpy(&header, snapshotFile.GetData(), sizeof(header));
+    const uint64_t sampleCount = static_cast<uint64_t>(header.orderCapacity / ORDER_SAMPLE_RATE + 1);
+    const bool valid = std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) == 0
+        && header.version == SNAPSHOT_VERSION
+        && header.nodeSize == sizeof(Node)
+        && header.checksum == KeyFileChecksum(reinterpret_cast<const int*>(&header), offsetof(SnapshotHeader, checksum) / sizeof(int))
+        && header.fileSize == snapshotFile.GetSize()
+        && header.tableSize > 0 && header.orderCapacity > 0
+        && header.orderCount >= 0 && header.orderCount <= header.orderCapacity && header.filterBlocks >= 0
+        && header.hashPolicy >= 0 && header.hashPolicy < HASH_POLICY_COUNT
+        && header.tableOffset + sizeof(Node) * static_cast<uint64_t>(header.tableSize) <= header.fileSize
+        && header.probeKeysOffset + sizeof(int) * static_cast<uint64_t>(header.tableSize) <= header.fileSize
+        && header.orderKeysOffset + sizeof(int) * static_cast<uint64_t>(header.orderCapacity) <= header.fileSize
+        && header.orderBucketsOffset + sizeof(int) * static_cast<uint64_t>(header.orderCapacity) <= header.fileSize
+        && header.sampleKeysOffset + sizeof(int) * sampleCount <= header.fileSize
+        && header.bucketPositionsOffset + sizeof(int) * static_cast<uint64_t>(header.tableSize) <= header.fileSize
+        && header.filterOffset + sizeof(BloomBlock) * static_cast<uint64_t>(header.filterBlocks) <= header.fileSize
+        && header.statsOffset + 2 * sizeof(HistogramCounts) <= header.fileSize;
+    if (!valid) {
+        snapshotFile.Close();
+        return false;
+    }
+
+    char* data = snapshotFile.GetWritableData();
+    tableSize = header.tableSize;
+    hashPolicy = static_cast<HashPolicy>(header.hashPolicy);
+    orderCapacity = header.orderCapacity;
+    table = reinterpret_cast<Node*>(data + header.tableOffset);
+    probeKeys = reinterpret_cast<std::atomic<int>*>(data + header.probeKeysOffset);
+    orderKeys = reinterpret_cast<int*>(data + header.orderKeysOffset);
+    orderBuckets = reinterpret_cast<int*>(data + header.orderBucketsOffset);
+    sampleKeys = reinterpret_cast<int*>(data + header.sampleKeysOffset);
+    bucketPositions = reinterpret_cast<int*>(data + header.bucketPositionsOffset);
+    filter.Attach(reinterpret_cast<BloomBlock*>(data + header.filterOffset), header.filterBlocks);
+    occupiedBuckets = header.occupiedBuckets;
+    orderCount = header.orderCount;
+    HistogramCounts stats[2];
+    std::memcpy(stats, data + header.statsOffset, sizeof(stats));
+    insertProbes.Load(stats[0]);
+    chainLengths.Load(stats[1]);
+    ResetSearchStats();
+
+    tableStorage.reset();
+    probeKeyStorage.reset();
+    orderKeyStorage.reset();
+    orderBucketStorage.reset();
+    sampleKeyStorage.reset();
+    bucketPositionStorage.reset();
+    return true;
+}
@@ -1,33 +1,147 @@
 #pragma once
 
+#include "Arena.h"
+#include "BloomFilter.h"
+#include "Loader.h"
+#include "Stats.h"
 #include "globals.h"
 #include "node.h"
 
+#include <atomic>
+#include <climits>
+
+constexpr int EMPTY_BUCKET = INT_MIN; // Marks a free bucket in the probe key array, so it cannot itself be stored as a key.
+
+constexpr int SEARCH_BATCH_WIDTH = 16; // Lookups kept in flight at once by SearchBatch.
+constexpr int PARALLEL_LOAD_THRESHOLD = 1 << 14; // Fewer keys than this are bulk loaded by the calling thread alone.
+constexpr int ORDER_SAMPLE_RATE = 64; // Every this many keys of the ordered view is sampled into the sparse order index.
+
+// How a HashTable hashes keys, HASH_POLICY unless set otherwise. Either hash is reduced to a bucket with a multiply and
+// a shift rather than a division.
+enum HashPolicy {
+	HASH_MULTIPLY_SHIFT = 0, // One multiply by an odd constant, keeping the high bits: the cheapest, and spreads runs of consecutive keys.
+	HASH_MIXER = 1, // The murmur3 64-bit finalizer: two more multiplies, but every bit of the key reaches every bit of the hash.
+	HASH_POLICY_COUNT
+};
+
+// The probe sequence of one key, worked out once so that every further probe is an add and a compare.
+struct ProbeSequence {
+	int bucket; // The bucket of the current probe, the key's home bucket at first.
+	int step; // The distance to the next probe, from 1 to the table size - 1.
+};
+
+// The outcome of one lookup made by SearchBatch.
+struct SearchResult {
+	int bucket; // The bucket holding the key, -1 when the key is absent.
+	int searchAttempts; // The number of buckets probed.
+	bool found; // True when the key is present.
+};
+
+// Keys arrive in ascending order, so the ordered view is two contiguous arrays filled front to back: the keys and the
+// buckets holding them. In-order scans read them sequentially rather than chasing links across the table. Every bucket
+// also records the position of its key, so an ordered query for a key in the table starts from a hash hit, and only
+// other keys need the sparse order index.
+//
+// The table supports one writer thread inserting while any number of reader threads search or read the ordered
+// view. A bucket's Node is filled in before its key is published to probeKeys with a release store, and a key is
+// appended to the ordered view only after that, with orderCount published last, so a reader that sees a key or a
+// position also sees the complete bucket. The table never moves buckets, so nothing has to be reclaimed while
+// readers are active. BulkLoad is the exception: it fills buckets from several threads before their Nodes are complete,
+// so it must finish before readers start.
+//
+// When LOOKUP_FILTER_BITS is above 0 every key is also added to a Bloom filter before it is published, and lookups test
+// the filter first, so most searches for absent keys finish without probing at all.
+//
+// Statistics are kept up to date as the table is used rather than gathered by scanning it: histograms of the buckets
+// probed by inserts and, when COLLECT_SEARCH_STATS is set, by searches that hit or miss, and of how many keys had every
+// bucket as their home, which is how long its chain would be if chaining was used. DumpStats prints them all at once.
+// Search records into the shared histograms on every call, which readers on several threads contend for, so search
+// statistics are off by default; SearchBatch counts into local HistogramCounts and merges them once per batch.
+//
+// A key's hash picks both its home bucket and the step between its probes (double hashing), each reduced onto the
+// table with Lemire's multiply-high reduction. The table size is rounded up to a prime, so whatever the step, a probe
+// sequence visits every bucket once before repeating.
+//
+// A built table can be saved with SaveSnapshot and reopened with LoadSnapshot, which maps the file and uses its arrays
+// in place. The mapping is copy-on-write, so a reopened table can still be inserted into without changing the file.
 class HashTable {
 public:
 	HashTable();
 	HashTable(const int size);
 	~HashTable(void);
+	void Allocate(const int size);
+	void Allocate(const int size, Arena& arena);
+	bool SaveSnapshot(const char* path);
+	bool LoadSnapshot(const char* path);
 	std::unique_ptr<Node[]> AllocateArrayNode(const int arraySize);
-	int GetHead(void);
+	std::unique_ptr<std::atomic<int>[]> AllocateArrayAtomic(const int arraySize, const int value);
+	int GetOrderedCount(void);
+	int GetOrderedKey(const int position);
+	int GetOrderedBucket(const int position);
 	int GetTableSize(void);
-	std::unique_ptr<Node[]>& GetTable(void);
+	Node* GetTable(void);
 	int GetOccupiedBuckets(void);
+	bool HasFilter(void);
+	double GetFilterFalsePositiveRate(void);
 	void IncrementOccupiedBuckets(void);
+	bool AppendOrdered(const int key, const int bucket);
+	int FindSampleBelow(const int key, const int count);
+	int FindSampleNotAbove(const int key, const int count);
+	int FindOrderedPosition(const int key, const int count);
 	bool SetHead(Node headNode, int& prevBucket);
-	int Probe(const int key, const int i);
-	int HashFunction1(const int key);
-	int HashFunction2(const int key);
-	int HashFunction3(const int key);
+	bool SetHashPolicy(const HashPolicy policy);
+	HashPolicy GetHashPolicy(void);
+	ProbeSequence StartProbe(const int key);
+	void NextProbe(ProbeSequence& probe);
 	bool HeadInsert(Node headNode, int& prevBucket);
+	bool BulkLoad(const int* keys, int count, int threadCount);
 	bool Search(const int searchKey,Node& result, int& searchAttempts);
+	void SearchBatch(const int* searchKeys, const int count, SearchResult* results);
+	int FindBucket(const int searchKey, int& searchAttempts);
+	int LowerBound(const int key);
+	int UpperBound(const int key);
+	int Successor(const int key);
+	int Predecessor(const int key);
+	int RangeScan(const int low, const int high, int* buckets, const int capacity);
 	void PrintTable(void);
 	void PrintList(void);
 	int PopularBucketChain(void);
 	int CalculateOnePlusBuckets(void);
+	double GetLoadFactor(void);
+	int GetMaxDisplacement(void);
+	Histogram& GetInsertProbes(void);
+	Histogram& GetHitProbes(void);
+	Histogram& GetMissProbes(void);
+	Histogram& GetChainLengths(void);
+	PhaseTimers& GetPhaseTimers(void);
+	void ResetSearchStats(void);
+	void DumpStats(std::ostream& out);
 private:
-	int tableSize; // The size of the table: will be three times the number of records.
-	int headBucket; // The first occupied bucket in ascending order.
-	int occupiedBuckets; // The number of buckets that are occupied in the table.
-	std::unique_ptr<Node[]> table; // Dynamically allocated array of Nodes.
+	void AllocateStorage(Arena* arena);
+	void ClearContents(void);
+	int tableSize; // The size of the table: the first prime from three times the number of records.
+	HashPolicy hashPolicy; // How keys are hashed onto the table.
+	std::atomic<int> occupiedBuckets; // The number of buckets that are occupied in the table.
+	Node* table; // Array of Nodes holding the payload and statistics of every bucket.
+	std::atomic<int>* probeKeys; // The key of every bucket, or EMPTY_BUCKET, packed 16 to a cache line for probing.
+	int orderCapacity; // The number of keys the ordered view can hold: the number of records the table was sized for.
+	int* orderKeys; // The keys of the table in ascending order.
+	int* orderBuckets; // orderBuckets[p] is the bucket holding orderKeys[p].
+	int* sampleKeys; // orderKeys[s * ORDER_SAMPLE_RATE] for every s, a cache resident index over orderKeys.
+	int* bucketPositions; // bucketPositions[b] is the position in the ordered view of the key in bucket b, -1 when empty.
+	std::atomic<int> orderCount; // The number of keys published to the ordered view.
+	BloomFilter filter; // Holds every key of the table, tested before probing.
+	// The arrays above point into this storage, into an arena, or into snapshotFile when the table was loaded from a snapshot.
+	std::unique_ptr<Node[]> tableStorage;
+	std::unique_ptr<std::atomic<int>[]> probeKeyStorage;
+	std::unique_ptr<int[]> orderKeyStorage;
+	std::unique_ptr<int[]> orderBucketStorage;
+	std::unique_ptr<int[]> sampleKeyStorage;
+	std::unique_ptr<int[]> bucketPositionStorage;
+	MappedFile snapshotFile; // The mapped snapshot, closed unless the table was loaded from one.
+	Histogram insertProbes; // The buckets probed by every insert.
+	Histogram hitProbes; // The buckets probed by every search that found its key, when COLLECT_SEARCH_STATS is set.
+	Histogram missProbes; // The buckets probed by every search that did not, 0 when the filter ruled the key out, likewise.
+	Histogram chainLengths; // Counts every bucket by the keys that had it as their home, 0 for most.
+	PhaseTimers phases; // The time spent reading, sorting and inserting the keys, or reopening a snapshot.
 };
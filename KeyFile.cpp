@@ -0,0 +1,134 @@
+#include "KeyFile.h"
+
+#include <climits>
+#include <cstring>
+
+bool IsBinaryKeyFile(const char* data, const size_t size) {
+    return size >= sizeof(KeyFileHeader) && std::memcmp(data, KEY_FILE_MAGIC, sizeof(KEY_FILE_MAGIC)) == 0;
+}
+
+// Given:  hash         - The checksum of the keys preceding this batch.
+//         keys         - The batch of keys to be added.
+//         count        - The number of elements in the keys array.
+//
+// Task:   To continue an FNV-1a checksum over another batch of keys.
+//
+// Return: The checksum including the batch.
+static uint32_t ContinueChecksum(uint32_t hash, const int* keys, const size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        hash = (hash ^ static_cast<uint32_t>(keys[i])) * 16777619u;
+    }
+    return hash;
+}
+
+uint32_t KeyFileChecksum(const int* keys, const size_t count) {
+    return ContinueChecksum(2166136261u, keys, count);
+}
+
+bool ReadKeyFileHeader(const char* data, const size_t size, KeyFileHeader& header) {
+    if (!IsBinaryKeyFile(data, size)) {
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(KeyFileHeader));
+
+    if (header.version != KEY_FILE_VERSION || header.keyWidth != sizeof(int)) {
+        return false;
+    }
+    if (header.count > static_cast<uint64_t>(INT_MAX)) {
+        return false; // Key counts are ints everywhere past the header.
+    }
+    if (header.count > static_cast<uint64_t>((size - sizeof(KeyFileHeader)) / sizeof(int))
+        || sizeof(KeyFileHeader) + header.count * sizeof(int) != size) {
+        return false; // Truncated, or trailing bytes after the keys.
+    }
+
+    const int* keys = reinterpret_cast<const int*>(data + sizeof(KeyFileHeader));
+    return KeyFileChecksum(keys, static_cast<size_t>(header.count)) == header.checksum;
+}
+
+bool WriteKeyFile(const char* path, const int* keys, const int count, const bool sorted) {
+    KeyFileHeader header;
+    std::memcpy(header.magic, KEY_FILE_MAGIC, sizeof(KEY_FILE_MAGIC));
+    header.version = KEY_FILE_VERSION;
+    header.keyWidth = sizeof(int);
+    header.count = static_cast<uint64_t>(count);
+    header.flags = sorted ? KEY_FILE_SORTED : 0u;
+    header.checksum = KeyFileChecksum(keys, static_cast<size_t>(count));
+
+    std::ofstream outFile(path, std::ios::binary | std::ios::trunc);
+    if (outFile.fail()) {
+        return false;
+    }
+    outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    outFile.write(reinterpret_cast<const char*>(keys), static_cast<std::streamsize>(sizeof(int)) * count);
+    outFile.close();
+    return !outFile.fail();
+}
+
+// Given:  Nothing.
+//
+// Task:   To initialize a writer with no file open.
+//
+// Return: Nothing.
+KeyFileWriter::KeyFileWriter(void) {
+    count = 0;
+    checksum = KeyFileChecksum(nullptr, 0);
+}
+
+// Given:  Nothing.
+//
+// Task:   To destroy the writer, an unfinished file is left with an invalid header.
+//
+// Return: Nothing.
+KeyFileWriter::~KeyFileWriter(void) {
+
+}
+
+// Given:  path     - The path of the file to write.
+//
+// Task:   To create the file and reserve room for its header.
+//
+// Return: true or false        - True indicating the file is open, False indicating it could not be created.
+bool KeyFileWriter::Open(const char* path) {
+    outFile.open(path, std::ios::binary | std::ios::trunc);
+    if (outFile.fail()) {
+        return false;
+    }
+    KeyFileHeader placeholder = {}; // Zeroed magic, so a file that is never closed is not mistaken for a key file.
+    outFile.write(reinterpret_cast<const char*>(&placeholder), sizeof(placeholder));
+    count = 0;
+    checksum = KeyFileChecksum(nullptr, 0);
+    return !outFile.fail();
+}
+
+// Given:  keys     - The batch of keys to be appended.
+//         keyCount - The number of elements in the keys array.
+//
+// Task:   To append a batch of keys to the file.
+//
+// Return: Nothing.
+void KeyFileWriter::Write(const int* keys, const int keyCount) {
+    outFile.write(reinterpret_cast<const char*>(keys), static_cast<std::streamsize>(sizeof(int)) * keyCount);
+    checksum = ContinueChecksum(checksum, keys, static_cast<size_t>(keyCount));
+    count += static_cast<uint64_t>(keyCount);
+}
+
+// Given:  sorted   - Whether the keys were written in ascending order.
+//
+// Task:   To write the final header at the start of the file and close it.
+//
+// Return: true or false        - True indicating the file was completed, False indicating a write failure.
+bool KeyFileWriter::Close(const bool sorted) {
+    KeyFileHeader header;
+    std::memcpy(header.magic, KEY_FILE_MAGIC, sizeof(KEY_FILE_MAGIC));
+    header.version = KEY_FILE_VERSION;
+    header.keyWidth = sizeof(int);
+    header.count = count;
+    header.flags = sorted ? KEY_FILE_SORTED : 0u;
+    header.checksum = checksum;
+
+    outFile.seekp(0, std::ios::beg);
+    outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    outFile.close();
+    return !outFile.fail();
+}
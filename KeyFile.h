@@ -0,0 +1,73 @@
+#pragma once
+
+#include "globals.h"
+
+#include <cstddef>
+#include <cstdint>
+
+constexpr char KEY_FILE_MAGIC[8] = { 'R', 'D', 'X', 'K', 'E', 'Y', 'S', '\0' };
+constexpr uint32_t KEY_FILE_VERSION = 1;
+constexpr uint32_t KEY_FILE_SORTED = 1u; // Flag bit set when the keys are stored in ascending order.
+
+// Header of a binary key file. It is followed directly by count packed little-endian 32-bit keys.
+struct KeyFileHeader {
+    char magic[8]; // KEY_FILE_MAGIC, identifies the format.
+    uint32_t version; // KEY_FILE_VERSION of the writer.
+    uint32_t keyWidth; // Width of one key in bytes, always 4.
+    uint64_t count; // The number of keys following the header.
+    uint32_t flags; // KEY_FILE_SORTED when the keys are in ascending order.
+    uint32_t checksum; // KeyFileChecksum of the key array.
+};
+
+static_assert(sizeof(KeyFileHeader) == 32, "The key file header must stay 32 bytes so the keys stay aligned.");
+
+// Given:  data         - The contents of a file.
+//         size         - The number of bytes in data.
+//
+// Task:   To determine whether data starts with a binary key file header.
+//
+// Return: true or false        - True indicating the magic matches, False indicating a text (or unknown) file.
+bool IsBinaryKeyFile(const char* data, const size_t size);
+
+// Given:  keys         - The array of keys to be summed.
+//         count        - The number of elements in the keys array.
+//
+// Task:   To compute the FNV-1a hash of the keys, taking a 32-bit word at a time.
+//
+// Return: The checksum of the keys.
+uint32_t KeyFileChecksum(const int* keys, const size_t count);
+
+// Given:  data         - The contents of a binary key file.
+//         size         - The number of bytes in data.
+//         header       - A header which currently contains dummy information.
+//
+// Task:   To validate the header (magic, version, key width, key count, file length and checksum) of a binary key
+//         file. A file of more than INT_MAX keys is rejected, as the sort and the tables count keys in an int.
+//
+// Return: true or false                - True indicating a valid file, False indicating a damaged or foreign file.
+//         header (via reference)       - A copy of the file's header.
+bool ReadKeyFileHeader(const char* data, const size_t size, KeyFileHeader& header);
+
+// Given:  path         - The path of the file to write.
+//         keys         - The array of keys to be written.
+//         count        - The number of elements in the keys array.
+//         sorted       - Whether the keys are in ascending order.
+//
+// Task:   To write the keys out as a binary key file.
+//
+// Return: true or false        - True indicating the file was written, False indicating a write failure.
+bool WriteKeyFile(const char* path, const int* keys, const int count, const bool sorted);
+
+// Writes a binary key file a batch of keys at a time, filling in the count and checksum of the header on Close.
+class KeyFileWriter {
+public:
+	KeyFileWriter();
+	~KeyFileWriter(void);
+	bool Open(const char* path);
+	void Write(const int* keys, const int keyCount);
+	bool Close(const bool sorted);
+private:
+	std::ofstream outFile; // The file being written.
+	uint64_t count; // The number of keys written so far.
+	uint32_t checksum; // Running KeyFileChecksum of the keys written so far.
+};
@@ -0,0 +1,292 @@
+#include "Loader.h"
+
+#include <climits>
+#include <cstdint>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Given:  Nothing.
+//
+// Task:   To initialize an empty mapping.
+//
+// Return: Nothing.
+MappedFile::MappedFile(void) {
+    data = nullptr;
+    size = 0;
+#ifdef _WIN32
+    fileHandle = INVALID_HANDLE_VALUE;
+    mappingHandle = nullptr;
+#else
+    fileDescriptor = -1;
+#endif
+}
+
+// Given:  Nothing.
+//
+// Task:   To unmap the file and close it.
+//
+// Return: Nothing.
+MappedFile::~MappedFile(void) {
+    Close();
+}
+
+// Given:  path     - The path of the file to map.
+//
+// Task:   To open the file and map all of it copy-on-write into memory. An empty file opens with no data.
+//
+// Return: true or false        - True indicating the file is mapped, False indicating it could not be opened or mapped.
+bool MappedFile::Open(const char* path) {
+    Close();
+#ifdef _WIN32
+    fileHandle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize)) {
+        Close();
+        return false;
+    }
+    size = static_cast<size_t>(fileSize.QuadPart);
+    if (size == 0) {
+        return true;
+    }
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (mappingHandle == nullptr) {
+        Close();
+        return false;
+    }
+    data = static_cast<char*>(MapViewOfFile(mappingHandle, FILE_MAP_COPY, 0, 0, 0));
+#else
+    fileDescriptor = open(path, O_RDONLY);
+    if (fileDescriptor < 0) {
+        return false;
+    }
+    struct stat status;
+    if (fstat(fileDescriptor, &status) != 0) {
+        Close();
+        return false;
+    }
+    size = static_cast<size_t>(status.st_size);
+    if (size == 0) {
+        return true;
+    }
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileDescriptor, 0);
+    if (mapping == MAP_FAILED) {
+        Close();
+        return false;
+    }
+    madvise(mapping, size, MADV_SEQUENTIAL); // The parser reads the file front to back exactly once.
+    data = static_cast<char*>(mapping);
+#endif
+    if (data == nullptr) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+// Given:  Nothing.
+//
+// Task:   To unmap and close the file if one is open.
+//
+// Return: Nothing.
+void MappedFile::Close(void) {
+#ifdef _WIN32
+    if (data != nullptr) {
+        UnmapViewOfFile(data);
+    }
+    if (mappingHandle != nullptr) {
+        CloseHandle(mappingHandle);
+        mappingHandle = nullptr;
+    }
+    if (fileHandle != INVALID_HANDLE_VALUE) {
+        CloseHandle(fileHandle);
+        fileHandle = INVALID_HANDLE_VALUE;
+    }
+#else
+    if (data != nullptr) {
+        munmap(data, size);
+    }
+    if (fileDescriptor >= 0) {
+        close(fileDescriptor);
+        fileDescriptor = -1;
+    }
+#endif
+    data = nullptr;
+    size = 0;
+}
+
+// Given:  Nothing.
+//
+// Task:   To simply return data.
+//
+// Return: data       - The first byte of the mapped file.
+const char* MappedFile::GetData(void) {
+    return data;
+}
+
+// Given:  Nothing.
+//
+// Task:   To return data for modification, which only touches this process's copy of the pages written.
+//
+// Return: data       - The first byte of the mapped file.
+char* MappedFile::GetWritableData(void) {
+    return data;
+}
+
+// Given:  Nothing.
+//
+// Task:   To simply return size.
+//
+// Return: size       - The number of bytes in the mapped file.
+size_t MappedFile::GetSize(void) {
+    return size;
+}
+
+// Given:  offset   - The offset of the first byte no longer needed.
+//         length   - The number of bytes no longer needed.
+//
+// Task:   To let the operating system drop the whole pages of the range from this process, so a file read once from
+//         front to back does not stay resident. Pages are read back in from the file if touched again, and anything
+//         written to them through GetWritableData is discarded.
+//
+// Return: Nothing.
+void MappedFile::Release(const size_t offset, const size_t length) {
+#ifndef _WIN32
+    const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t first = (offset + pageSize - 1) / pageSize * pageSize;
+    const size_t last = (offset + length) / pageSize * pageSize;
+    if (data != nullptr && first < last && last <= size) {
+        madvise(data + first, last - first, MADV_DONTNEED);
+    }
+#else
+    (void)offset;
+    (void)length;
+#endif
+}
+
+int CountRecords(const char* data, const size_t size) {
+    int records = 0;
+    const char* end = data + size;
+    const char* current = data;
+    const char* lastLine = data;
+
+    // memchr is vectorized by the C library, so this is a SIMD scan for line feeds.
+    while (current < end && (current = static_cast<const char*>(std::memchr(current, '\n', end - current))) != nullptr) {
+        // Blank lines, including a trailing CRLF pair, are not records.
+        if (current > lastLine && !(current - lastLine == 1 && *lastLine == '\r')) {
+            records++;
+        }
+        current++;
+        lastLine = current;
+    }
+    if (lastLine < end) {
+        records++; // The last line has no line feed.
+    }
+    return records;
+}
+
+// Given:  chunk    - Eight bytes of text loaded little-endian, so the first character is the lowest byte.
+//
+// Task:   To find how many of the leading characters in chunk are decimal digits.
+//
+// Return: An integer from 0 to 8 representing the length of the leading run of digits.
+static inline int LeadingDigits(const uint64_t chunk) {
+    // A byte is a digit when its high nibble is 3 and adding 6 keeps it there; both tests leave zero bytes for digits.
+    uint64_t highNibbles = chunk & 0xF0F0F0F0F0F0F0F0ull;
+    uint64_t carried = (chunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull;
+    uint64_t nonDigits = (highNibbles ^ 0x3030303030303030ull) | (carried ^ 0x3030303030303030ull);
+    if (nonDigits == 0) {
+        return 8;
+    }
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(nonDigits) / 8;
+#else
+    int length = 0;
+    while ((nonDigits & 0xFF) == 0) {
+        nonDigits >>= 8;
+        length++;
+    }
+    return length;
+#endif
+}
+
+// Given:  chunk    - Eight bytes of text loaded little-endian, beginning with length digits.
+//         length   - The number of leading digits to convert, from 1 to 8.
+//
+// Task:   To convert the digits to their value with three multiply-and-mask steps instead of one step per digit.
+//
+// Return: The value of the leading digits.
+static inline int ConvertDigits(uint64_t chunk, const int length) {
+    chunk -= 0x3030303030303030ull;
+    chunk <<= 8 * (8 - length); // Shifting in zero bytes below the digits acts as leading zeros.
+    chunk = (chunk * 10 + (chunk >> 8)) & 0x00FF00FF00FF00FFull;
+    chunk = (chunk * 100 + (chunk >> 16)) & 0x0000FFFF0000FFFFull;
+    chunk = (chunk * 10000 + (chunk >> 32)) & 0x00000000FFFFFFFFull;
+    return static_cast<int>(chunk);
+}
+
+int ParseKeys(const char* data, const size_t size, int* keys, const int capacity) {
+    size_t position = 0;
+    return ParseKeysFrom(data, size, position, keys, capacity);
+}
+
+int ParseKeysFrom(const char* data, const size_t size, size_t& position, int* keys, const int capacity) {
+    int count = 0;
+    const char* current = data + position;
+    const char* end = data + size;
+
+    while (current < end && count < capacity) {
+        // Skip line endings and blanks between records.
+        if (*current == '\n' || *current == '\r' || *current == ' ' || *current == '\t') {
+            current++;
+            continue;
+        }
+
+        bool negative = false;
+        if (*current == '-') {
+            negative = true;
+            current++;
+        }
+
+        // Accumulated wider than an int and held just past the largest magnitude an int can take, so a long run of
+        // digits can neither overflow nor wrap into range.
+        const long long limit = negative ? -static_cast<long long>(INT_MIN) : INT_MAX;
+        const char* digits = current;
+        long long value = 0;
+        if (end - current >= 8) {
+            uint64_t chunk;
+            std::memcpy(&chunk, current, sizeof(chunk));
+            int length = LeadingDigits(chunk);
+            if (length > 0 && length < 8) {
+                value = ConvertDigits(chunk, length);
+                current += length;
+            }
+        }
+        while (current < end && *current >= '0' && *current <= '9') {
+            value = (value > limit) ? limit + 1 : value * 10 + (*current - '0');
+            current++;
+        }
+
+        // A line without digits, such as a header, or with a value out of range, is skipped rather than stored.
+        if (current > digits && value <= limit) {
+            keys[count++] = static_cast<int>(negative ? -value : value);
+        }
+
+        // Skip anything else left on the line.
+        while (current < end && *current != '\n') {
+            current++;
+        }
+    }
+    position = static_cast<size_t>(current - data);
+    return count;
+}
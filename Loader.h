@@ -0,0 +1,62 @@
+#pragma once
+
+#include "globals.h"
+
+#include <cstddef>
+
+// A private, copy-on-write view of a whole file mapped into memory. Writes through the view stay in this process.
+class MappedFile {
+public:
+	MappedFile();
+	~MappedFile(void);
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	bool Open(const char* path);
+	void Close(void);
+	const char* GetData(void);
+	char* GetWritableData(void);
+	size_t GetSize(void);
+	void Release(const size_t offset, const size_t length);
+private:
+	char* data; // First byte of the mapping, nullptr when nothing is mapped or the file is empty.
+	size_t size; // The number of bytes in the file.
+#ifdef _WIN32
+	void* fileHandle; // Handle of the open file.
+	void* mappingHandle; // Handle of the file mapping object.
+#else
+	int fileDescriptor; // Descriptor of the open file, -1 when closed.
+#endif
+};
+
+// Given:  data         - The text of a key file, one integer per line with LF or CRLF line endings.
+//         size         - The number of bytes in data.
+//
+// Task:   To count the records in the text by scanning for line feeds, counting a last line without one as well.
+//
+// Return: An integer representing the number of records in the text.
+int CountRecords(const char* data, const size_t size);
+
+// Given:  data         - The text of a key file, one integer per line with LF or CRLF line endings.
+//         size         - The number of bytes in data.
+//         keys         - The array the parsed integers are stored into.
+//         capacity     - The number of elements the keys array can hold.
+//
+// Task:   To parse the integers in data straight into keys. Runs of up to eight digits are converted eight bytes at a
+//         time (SWAR), anything else falls back to a byte at a time. Lines without digits, and values outside the
+//         range of an int, are skipped.
+//
+// Return: An integer representing the number of keys parsed.
+int ParseKeys(const char* data, const size_t size, int* keys, const int capacity);
+
+// Given:  data         - The text of a key file, one integer per line with LF or CRLF line endings.
+//         size         - The number of bytes in data.
+//         position     - The offset in data to resume parsing from.
+//         keys         - The array the parsed integers are stored into.
+//         capacity     - The number of elements the keys array can hold.
+//
+// Task:   To parse up to capacity integers from data starting at position, so a large file can be read in chunks.
+//         Lines are skipped as by ParseKeys.
+//
+// Return: An integer representing the number of keys parsed.
+//         position (via reference)     - The offset just after the last line parsed.
+int ParseKeysFrom(const char* data, const size_t size, size_t& position, int* keys, const int capacity);
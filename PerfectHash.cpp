@@ -0,0 +1,267 @@
+#include "PerfectHash.h"
+
+#include <algorithm>
+#include <vector>
+
+// Given:  x        - A 64-bit value.
+//
+// Task:   To scramble x so every output bit depends on every input bit (the splitmix64 finalizer). The mix is a
+//         bijection, so distinct inputs never collide.
+//
+// Return: The mixed value.
+static inline uint64_t Mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+// Given:  Nothing.
+//
+// Task:   To initialize an empty table.
+//
+// Return: Nothing.
+PerfectHashTable::PerfectHashTable(void) {
+    tableSize = 0;
+    positionCount = 0;
+    bucketCount = 0;
+    seed = 0;
+}
+
+// Given:  Nothing.
+//
+// Task:   To destroy the table and release any allocated memory.
+//
+// Return: Nothing.
+PerfectHashTable::~PerfectHashTable(void) {
+
+}
+
+// Given:  Nothing.
+//
+// Task:   To simply return tableSize.
+//
+// Return: tableSize       - The number of slots in the table.
+int PerfectHashTable::GetTableSize(void) {
+    return tableSize;
+}
+
+// Given:  Nothing.
+//
+// Task:   To return the number of occupied slots, which is every slot.
+//
+// Return: tableSize       - The number of slots that are occupied in the table.
+int PerfectHashTable::GetOccupiedBuckets(void) {
+    return tableSize;
+}
+
+// Given:  Nothing.
+//
+// Task:   To simply return bucketCount.
+//
+// Return: bucketCount     - The number of pilots the table keeps.
+int PerfectHashTable::GetBucketCount(void) {
+    return bucketCount;
+}
+
+// Given:  key  - Integer representing the key to be hashed.
+//
+// Task:   To mix the key with the current seed. The high 32 bits choose the key's bucket, and the whole hash, mixed
+//         with the bucket's pilot, chooses its slot.
+//
+// Return: The hash of the key.
+uint64_t PerfectHashTable::Hash(const int key) {
+    return Mix(static_cast<uint64_t>(static_cast<uint32_t>(key)) ^ seed);
+}
+
+// Given:  hash     - The hash of a key.
+//
+// Task:   To map the high half of the hash onto the buckets with a multiply and shift rather than a division.
+//
+// Return: The bucket of the key.
+int PerfectHashTable::BucketOf(const uint64_t hash) {
+    return static_cast<int>(((hash >> 32) * static_cast<uint64_t>(bucketCount)) >> 32);
+}
+
+// Given:  hash     - The hash of a key.
+//         pilot    - The pilot of the key's bucket.
+//
+// Task:   To remix the hash displaced by the pilot and map it onto the positions. The remix matters: keys of one
+//         bucket that share their top bits would otherwise share them under every pilot, and so always land together.
+//
+// Return: The position of the key, which is its slot unless it is past the last slot.
+int PerfectHashTable::Position(const uint64_t hash, const uint32_t pilot) {
+    const uint64_t displaced = Mix(hash ^ (static_cast<uint64_t>(pilot) * 0x9E3779B97F4A7C15ull));
+    return static_cast<int>(((displaced >> 32) * static_cast<uint64_t>(positionCount)) >> 32);
+}
+
+// Given:  sortedKeys   - The keys in ascending order; repeated keys are stored once.
+//         count        - The number of elements in the sortedKeys array.
+//
+// Task:   To build the table over the keys, trying new seeds while a bucket finds no pilot.
+//
+// Return: true or false        - True indicating the table was built, False indicating every seed failed.
+bool PerfectHashTable::Build(const int* sortedKeys, const int count) {
+    std::vector<int> distinct;
+    distinct.reserve(count);
+    for (int i = 0; i < count; i++) {
+        if (i == 0 || sortedKeys[i] != sortedKeys[i - 1]) {
+            distinct.push_back(sortedKeys[i]);
+        }
+    }
+
+    for (int attempt = 0; attempt < PERFECT_MAX_SEEDS; attempt++) {
+        seed = Mix(static_cast<uint64_t>(attempt) + 1);
+        if (TryBuild(distinct.data(), static_cast<int>(distinct.size()))) {
+            return true;
+        }
+    }
+    tableSize = 0;
+    positionCount = 0;
+    bucketCount = 0;
+    return false;
+}
+
+// Given:  distinctKeys - The keys in ascending order with no repeats.
+//         count        - The number of elements in the distinctKeys array.
+//
+// Task:   To build the table with the current seed. Buckets are placed from the largest down, as the large ones are
+//         the hardest to fit while the table is still empty. For each bucket pilots are tried in turn until one sends
+//         all its keys to distinct free positions. Every position taken past the last slot is then given one of the
+//         slots left free below it.
+//
+// Return: true or false        - True indicating the table was built, False indicating a bucket found no pilot.
+bool PerfectHashTable::TryBuild(const int* distinctKeys, const int count) {
+    tableSize = count;
+    positionCount = std::max(count, static_cast<int>(static_cast<long long>(count) * 100 / PERFECT_LOAD_PERCENT));
+    bucketCount = std::max(1, (count + PERFECT_BUCKET_KEYS - 1) / PERFECT_BUCKET_KEYS);
+    pilots.reset(new uint32_t[bucketCount]);
+    keys.reset(new int[std::max(1, count)]);
+    order.reset(new int[std::max(1, count)]);
+
+    // Group the key hashes by bucket: bucket b owns hashes[bucketStart[b] .. bucketStart[b + 1] - 1].
+    std::vector<int> bucketStart(bucketCount + 1, 0);
+    for (int i = 0; i < count; i++) {
+        bucketStart[BucketOf(Hash(distinctKeys[i])) + 1]++;
+    }
+    int largest = 0;
+    for (int b = 0; b < bucketCount; b++) {
+        largest = std::max(largest, bucketStart[b + 1]);
+        bucketStart[b + 1] += bucketStart[b];
+    }
+    std::vector<uint64_t> hashes(count);
+    std::vector<int> fill(bucketStart.begin(), bucketStart.end() - 1);
+    for (int i = 0; i < count; i++) {
+        const uint64_t hash = Hash(distinctKeys[i]);
+        hashes[fill[BucketOf(hash)]++] = hash;
+    }
+
+    // Order the buckets from the largest to the smallest with a counting sort on their sizes.
+    std::vector<int> sizeStart(largest + 2, 0);
+    for (int b = 0; b < bucketCount; b++) {
+        sizeStart[largest - (bucketStart[b + 1] - bucketStart[b]) + 1]++;
+    }
+    for (int s = 0; s <= largest; s++) {
+        sizeStart[s + 1] += sizeStart[s];
+    }
+    std::vector<int> bucketOrder(bucketCount);
+    for (int b = 0; b < bucketCount; b++) {
+        bucketOrder[sizeStart[largest - (bucketStart[b + 1] - bucketStart[b])]++] = b;
+    }
+
+    std::vector<unsigned char> taken(positionCount, 0);
+    std::vector<int> placed(largest);
+    for (int b : bucketOrder) {
+        const int first = bucketStart[b];
+        const int size = bucketStart[b + 1] - first;
+        uint32_t pilot = 0;
+        for (; pilot < PERFECT_MAX_PILOT; pilot++) {
+            int fitted = 0;
+            while (fitted < size) {
+                const int position = Position(hashes[first + fitted], pilot);
+                if (taken[position]) {
+                    break;
+                }
+                taken[position] = 1; // Taken at once, so two keys of the bucket landing together are caught too.
+                placed[fitted++] = position;
+            }
+            if (fitted == size) {
+                break;
+            }
+            for (int i = 0; i < fitted; i++) {
+                taken[placed[i]] = 0;
+            }
+        }
+        if (pilot == PERFECT_MAX_PILOT) {
+            return false;
+        }
+        pilots[b] = pilot;
+    }
+
+    // As many positions are taken past the last slot as slots are left free below it, so each gets its own. Positions
+    // left free point at slot 0, where an absent key that lands on them fails the key compare.
+    remap.reset(new int[std::max(1, positionCount - count)]());
+    int freeSlot = 0;
+    for (int position = count; position < positionCount; position++) {
+        if (taken[position]) {
+            while (taken[freeSlot]) {
+                freeSlot++;
+            }
+            remap[position - count] = freeSlot++;
+        }
+    }
+
+    for (int r = 0; r < count; r++) {
+        const int slot = Slot(distinctKeys[r]);
+        keys[slot] = distinctKeys[r];
+        order[r] = slot;
+    }
+    return true;
+}
+
+// Given:  key      - The key whose slot is wanted.
+//
+// Task:   To compute the one slot key could be in.
+//
+// Return: The slot for key, -1 while the table is empty. The slot holds key only when key was in the built set.
+int PerfectHashTable::Slot(const int key) {
+    if (tableSize == 0) {
+        return -1;
+    }
+    const uint64_t hash = Hash(key);
+    const int position = Position(hash, pilots[BucketOf(hash)]);
+    return (position < tableSize) ? position : remap[position - tableSize];
+}
+
+// Given:  searchKey          - An integer representing the key wished to be searched for.
+//         result             - A Struct of Node which contains dummy information.
+//         searchAttempts     - An integer which currently contains dummy information.
+//
+// Task:   To search for searchKey with a single slot access and one key compare.
+//
+// Return: true or false                    - True indicating the search value was found, False indicating it was not.
+//         result (via reference)           - A Struct of Node holding the key.
+//         searchAttempts (via reference)   - The number of slots probed, always 1 once the table holds keys.
+bool PerfectHashTable::Search(const int searchKey, Node& result, int& searchAttempts) {
+    const int slot = Slot(searchKey);
+    searchAttempts = (slot < 0) ? 0 : 1;
+    if (slot < 0 || keys[slot] != searchKey) {
+        return false;
+    }
+    result.SetKeys(searchKey);
+    result.SetInitialAttempts(1);
+    result.SetOccupancy(true);
+    return true;
+}
+
+// Given:  Nothing.
+//
+// Task:   To print the keys in ascending order.
+//
+// Return: Nothing.
+void PerfectHashTable::PrintList(void) {
+    for (int r = 0; r < tableSize; r++) {
+        std::cout << "Key: " << keys[order[r]] << ", ModKey: " << keys[order[r]] * 10 << std::endl;
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "globals.h"
+#include "node.h"
+
+#include <cstdint>
+
+constexpr int PERFECT_BUCKET_KEYS = 4;          // Average number of keys sharing one pilot.
+constexpr int PERFECT_LOAD_PERCENT = 99;        // Keys per 100 positions the pilots search over, so the last buckets placed still find free positions.
+constexpr uint32_t PERFECT_MAX_PILOT = 1u << 26; // Pilots tried for one bucket before the build starts over with a new seed.
+constexpr int PERFECT_MAX_SEEDS = 16;           // Seeds tried before the build gives up.
+
+// A static hash table over a fixed key set, built once with a minimal perfect hash in the PTHash style. Keys are
+// spread over buckets of about PERFECT_BUCKET_KEYS keys, and every bucket gets a pilot: a number that, mixed into the
+// hash of each of its keys, sends them to positions no other key uses. Pilots search a range of positions slightly
+// larger than the key count (PERFECT_LOAD_PERCENT), as with every position but a few taken the last buckets would need
+// a number of tries close to the key count. Keys sent past the last slot are then remapped, as in PTHash, to the slots
+// left free below it, so the table still has exactly one slot per key, and a lookup reads one pilot and one slot, plus
+// one remap entry for the few keys that need it. Keys cannot be added once the table is built.
+class PerfectHashTable {
+public:
+	PerfectHashTable();
+	~PerfectHashTable(void);
+	bool Build(const int* sortedKeys, const int count);
+	bool Search(const int searchKey, Node& result, int& searchAttempts);
+	int Slot(const int key);
+	void PrintList(void);
+	int GetTableSize(void);
+	int GetOccupiedBuckets(void);
+	int GetBucketCount(void);
+private:
+	uint64_t Hash(const int key);
+	int BucketOf(const uint64_t hash);
+	int Position(const uint64_t hash, const uint32_t pilot);
+	bool TryBuild(const int* keys, const int count);
+	int tableSize; // The number of slots, one per distinct key.
+	int positionCount; // The number of positions the pilots place keys at, tableSize / PERFECT_LOAD_PERCENT%.
+	int bucketCount; // The number of pilots.
+	uint64_t seed; // Mixed into every key hash; changed when a build attempt fails.
+	std::unique_ptr<uint32_t[]> pilots; // The pilot of every bucket.
+	std::unique_ptr<int[]> keys; // The key held by every slot.
+	std::unique_ptr<int[]> remap; // remap[p - tableSize] is the slot standing in for position p past the last slot.
+	std::unique_ptr<int[]> order; // order[r] is the slot holding the r-th smallest key.
+};
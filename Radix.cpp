@@ -0,0 +1,484 @@
+#include "Radix.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define RADIX_X86_KERNELS 1
+#else
+#define RADIX_X86_KERNELS 0
+#endif
+
+constexpr int HISTOGRAM_COPIES = 4;         // Interleaved histogram copies, so runs of equal digits hit different counters.
+constexpr int WRITE_COMBINE_KEYS = 16;      // Keys staged per bucket before a flush: one 64-byte cache line.
+constexpr int WRITE_COMBINE_THRESHOLD = 1 << 16;    // Passes over fewer keys scatter directly.
+constexpr int WRITE_COMBINE_MAX_BITS = 8;   // Wider digits scatter directly: 2^9 staging lines fill a 32KB L1.
+
+typedef void (*HistogramKernel)(const int* keys, const int arraySize, const int digitBits, int* copies);
+
+// Given:  copies       - HISTOGRAM_COPIES consecutive histogram sets of size entries each.
+//         size         - The number of counters in one histogram set, passes * 2^digitBits.
+//         histograms   - The histogram set the copies are added into.
+//
+// Task:   To sum the interleaved histogram copies into a single histogram set.
+//
+// Return: histograms   - The combined counts.
+static void FoldHistogramCopies(const int* copies, const int size, int* histograms) {
+    for (int c = 0; c < HISTOGRAM_COPIES; c++) {
+        for (int i = 0; i < size; i++) {
+            histograms[i] += copies[c * size + i];
+        }
+    }
+}
+
+// Given:  keys         - The array of keys to be counted.
+//         arraySize    - The number of elements in the keys array.
+//         digitBits    - The width of a digit in bits.
+//         copies       - HISTOGRAM_COPIES zeroed histogram sets.
+//
+// Task:   To count every digit of every pass, sending key j to histogram copy (j % HISTOGRAM_COPIES).
+//
+// Return: copies       - The interleaved counts.
+static void CountDigitsScalar(const int* keys, const int arraySize, const int digitBits, int* copies) {
+    const int passes = (RADIX_KEY_BITS + digitBits - 1) / digitBits;
+    const int buckets = 1 << digitBits;
+    const int size = passes * buckets;
+    const unsigned int mask = static_cast<unsigned int>(buckets - 1);
+
+    for (int j = 0; j < arraySize; j++) {
+        int* H = &copies[(j % HISTOGRAM_COPIES) * size];
+        for (int p = 0; p < passes; p++) {
+            H[p * buckets + RadixDigit(keys[j], p * digitBits, mask)]++;
+        }
+    }
+}
+
+#if RADIX_X86_KERNELS
+// Given:  keys         - The array of keys to be counted.
+//         arraySize    - The number of elements in the keys array.
+//         digitBits    - The width of a digit in bits.
+//         copies       - HISTOGRAM_COPIES zeroed histogram sets.
+//
+// Task:   To count every digit of every pass, extracting the digits of eight keys at a time with AVX2.
+//
+// Return: copies       - The interleaved counts.
+__attribute__((target("avx2")))
+static void CountDigitsAvx2(const int* keys, const int arraySize, const int digitBits, int* copies) {
+    const int passes = (RADIX_KEY_BITS + digitBits - 1) / digitBits;
+    const int buckets = 1 << digitBits;
+    const int size = passes * buckets;
+    const __m256i signFlip = _mm256_set1_epi32(static_cast<int>(0x80000000u));
+    const __m256i mask = _mm256_set1_epi32(buckets - 1);
+    alignas(32) int digits[8];
+
+    int j = 0;
+    for (; j + 8 <= arraySize; j += 8) {
+        __m256i v = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&keys[j])), signFlip);
+        for (int p = 0; p < passes; p++) {
+            __m256i d = _mm256_and_si256(_mm256_srlv_epi32(v, _mm256_set1_epi32(p * digitBits)), mask);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(digits), d);
+            int* H = &copies[p * buckets];
+            for (int lane = 0; lane < 8; lane++) {
+                H[(lane % HISTOGRAM_COPIES) * size + digits[lane]]++;
+            }
+        }
+    }
+    CountDigitsScalar(&keys[j], arraySize - j, digitBits, copies);
+}
+
+// Given:  keys         - The array of keys to be counted.
+//         arraySize    - The number of elements in the keys array.
+//         digitBits    - The width of a digit in bits.
+//         copies       - HISTOGRAM_COPIES zeroed histogram sets.
+//
+// Task:   To count every digit of every pass, extracting the digits of sixteen keys at a time with AVX-512.
+//
+// Return: copies       - The interleaved counts.
+__attribute__((target("avx512f")))
+static void CountDigitsAvx512(const int* keys, const int arraySize, const int digitBits, int* copies) {
+    const int passes = (RADIX_KEY_BITS + digitBits - 1) / digitBits;
+    const int buckets = 1 << digitBits;
+    const int size = passes * buckets;
+    const __m512i signFlip = _mm512_set1_epi32(static_cast<int>(0x80000000u));
+    const __m512i mask = _mm512_set1_epi32(buckets - 1);
+    alignas(64) int digits[16];
+
+    int j = 0;
+    for (; j + 16 <= arraySize; j += 16) {
+        __m512i v = _mm512_xor_si512(_mm512_loadu_si512(&keys[j]), signFlip);
+        for (int p = 0; p < passes; p++) {
+            __m512i d = _mm512_and_si512(_mm512_maskz_srlv_epi32(0xFFFF, v, _mm512_set1_epi32(p * digitBits)), mask);
+            _mm512_store_si512(digits, d);
+            int* H = &copies[p * buckets];
+            for (int lane = 0; lane < 16; lane++) {
+                H[(lane % HISTOGRAM_COPIES) * size + digits[lane]]++;
+            }
+        }
+    }
+    CountDigitsScalar(&keys[j], arraySize - j, digitBits, copies);
+}
+#endif
+
+// Given:  Nothing.
+//
+// Task:   To pick the widest digit counting kernel the running processor supports.
+//
+// Return: The selected kernel, CountDigitsScalar when no vector extension is available.
+static HistogramKernel SelectHistogramKernel(void) {
+#if RADIX_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return CountDigitsAvx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return CountDigitsAvx2;
+    }
+#endif
+    return CountDigitsScalar;
+}
+
+// Given:  source       - The buffer being distributed.
+//         destination  - The buffer receiving the keys.
+//         first, last  - The range [first, last) of source to distribute.
+//         shift, mask  - The position and mask of the digit being distributed on.
+//         C            - The next free destination slot of every digit, advanced as keys are written.
+//         staging      - 2^digitBits * WRITE_COMBINE_KEYS integers of staging space.
+//         fill         - 2^digitBits zeroed counters of the keys staged per digit.
+//
+// Task:   To scatter the range stably, staging each digit's keys in a cache line sized buffer and writing a full line
+//         to the destination at once, so the scatter touches far fewer distinct lines at a time.
+//
+// Return: destination  - The distributed keys.
+static void ScatterWriteCombined(const int* source, int* destination, const int first, const int last, const int shift,
+    const unsigned int mask, int* C, int* staging, unsigned char* fill) {
+
+    for (int j = first; j < last; j++) {
+        unsigned int digit = RadixDigit(source[j], shift, mask);
+        int* line = &staging[digit * WRITE_COMBINE_KEYS];
+        line[fill[digit]++] = source[j];
+        if (fill[digit] == WRITE_COMBINE_KEYS) {
+            std::memcpy(&destination[C[digit]], line, sizeof(int) * WRITE_COMBINE_KEYS);
+            C[digit] += WRITE_COMBINE_KEYS;
+            fill[digit] = 0;
+        }
+    }
+
+    for (unsigned int digit = 0; digit <= mask; digit++) {
+        if (fill[digit] > 0) {
+            std::memcpy(&destination[C[digit]], &staging[digit * WRITE_COMBINE_KEYS], sizeof(int) * fill[digit]);
+            C[digit] += fill[digit];
+            fill[digit] = 0;
+        }
+    }
+}
+
+// A barrier for a fixed number of threads, reused pass after pass: Wait returns once every thread has called it.
+// std::barrier would do, but the project builds as C++17.
+class PassBarrier {
+public:
+    explicit PassBarrier(const int threadCount) : threadCount(threadCount), waiting(0), generation(0) {}
+
+    void Wait(void) {
+        std::unique_lock<std::mutex> lock(mutex);
+        const unsigned long long arrival = generation;
+        if (++waiting == threadCount) {
+            waiting = 0;
+            generation++;
+            released.notify_all();
+        }
+        else {
+            released.wait(lock, [&] { return generation != arrival; });
+        }
+    }
+private:
+    std::mutex mutex;
+    std::condition_variable released;
+    const int threadCount; // The threads that must arrive before any is released.
+    int waiting; // The threads that have arrived in the current generation.
+    unsigned long long generation; // Advanced every time the barrier releases.
+};
+
+void BuildHistograms(const int* keys, const int arraySize, int digitBits, int* histograms, Arena& arena) {
+    static const HistogramKernel kernel = SelectHistogramKernel();
+
+    digitBits = SupportedDigitBits(digitBits);
+
+    const int passes = (RADIX_KEY_BITS + digitBits - 1) / digitBits;
+    const int size = passes * (1 << digitBits);
+
+    const ArenaMark mark = arena.Mark();
+    int* copies = arena.AllocateZeroed<int>(HISTOGRAM_COPIES * size);
+    kernel(keys, arraySize, digitBits, copies);
+    FoldHistogramCopies(copies, size, histograms);
+    arena.Rewind(mark);
+}
+
+void RadixSortKeys(int* keys, int* scratch, const int arraySize, int digitBits, Arena& arena) {
+
+    // Radix Sort with counting passes over fixed width digits has a running time of theta ( d (n + 2^b) ).
+    // Where d is the # of passes, b is the width of a digit in bits, and n is the length of the array.
+    // Unlike the decimal version, every histogram is gathered in one read of the array and the digits are extracted
+    // with a shift and a mask rather than a division.
+
+    if (arraySize < 2) {
+        return;
+    }
+
+    digitBits = SupportedDigitBits(digitBits);
+    const int passes = (RADIX_KEY_BITS + digitBits - 1) / digitBits;
+    const int buckets = 1 << digitBits;
+    const unsigned int mask = static_cast<unsigned int>(buckets - 1);
+
+    const ArenaMark mark = arena.Mark(); // Everything below is handed back to the arena once the keys are sorted.
+    int* histograms = arena.AllocateZeroed<int>(passes * buckets); // One allocation shared by all passes.
+    BuildHistograms(keys, arraySize, digitBits, histograms, arena);
+
+    // Staging lines for the write-combined scatter, left uninitialized as every slot is written before it is read.
+    const bool combine = arraySize >= WRITE_COMBINE_THRESHOLD && digitBits <= WRITE_COMBINE_MAX_BITS;
+    int* staging = combine ? arena.Allocate<int>(buckets * WRITE_COMBINE_KEYS) : nullptr;
+    unsigned char* fill = combine ? arena.AllocateZeroed<unsigned char>(buckets) : nullptr;
+
+    int* source = keys;
+    int* destination = scratch;
+
+    for (int p = 0; p < passes; p++) {
+        int* C = &histograms[p * buckets];
+        const int shift = p * digitBits;
+
+        // A pass where every key has the same digit would leave the order unchanged, skip it.
+        if (C[RadixDigit(source[0], shift, mask)] == arraySize) {
+            continue;
+        }
+
+        // Turn the counts into the starting offset of each digit.
+        int total = 0;
+        for (int i = 0; i < buckets; i++) {
+            int count = C[i];
+            C[i] = total;
+            total += count;
+        }
+
+        // Scatter forwards so that keys with equal digits keep their relative order.
+        if (combine) {
+            ScatterWriteCombined(source, destination, 0, arraySize, shift, mask, C, staging, fill);
+        }
+        else {
+            for (int j = 0; j < arraySize; j++) {
+                destination[C[RadixDigit(source[j], shift, mask)]++] = source[j];
+            }
+        }
+
+        int* temp = source;
+        source = destination;
+        destination = temp;
+    }
+
+    // An odd number of executed passes leaves the result in scratch, a single copy brings it back.
+    if (source != keys) {
+        std::memcpy(keys, source, sizeof(int) * arraySize);
+    }
+    arena.Rewind(mark);
+}
+
+void ParallelRadixSortKeys(int* keys, int* scratch, const int arraySize, int digitBits, int threadCount, Arena& arena) {
+
+    digitBits = SupportedDigitBits(digitBits);
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    if (threadCount <= 1 || arraySize < PARALLEL_SORT_THRESHOLD) {
+        RadixSortKeys(keys, scratch, arraySize, digitBits, arena);
+        return;
+    }
+
+    const int passes = (RADIX_KEY_BITS + digitBits - 1) / digitBits;
+    const int buckets = 1 << digitBits;
+    const unsigned int mask = static_cast<unsigned int>(buckets - 1);
+    const int chunkSize = (arraySize + threadCount - 1) / threadCount;
+
+    // Row t holds the counts, and later the scatter offsets, of thread t's chunk. With narrow digits every thread also
+    // gets its own staging lines for the scatter, taken from the arena up front since the arena is not thread safe.
+    // The scatter leaves every fill count at zero, so the staging is reused by every pass.
+    const ArenaMark mark = arena.Mark();
+    const bool combine = digitBits <= WRITE_COMBINE_MAX_BITS;
+    int* local = arena.Allocate<int>(threadCount * buckets);
+    int* staging = combine ? arena.Allocate<int>(threadCount * buckets * WRITE_COMBINE_KEYS) : nullptr;
+    unsigned char* fill = combine ? arena.AllocateZeroed<unsigned char>(threadCount * buckets) : nullptr;
+    PassBarrier barrier(threadCount);
+    bool trivial = false; // Written by thread 0 between the first two barriers of a pass, read by all after them.
+
+    // Runs every pass over chunk t, the threads meeting at the barrier between counting, merging and scattering.
+    // The threads are started once for the whole sort rather than once per phase of every pass.
+    auto SortChunk = [&](const int t) {
+        const int first = std::min(arraySize, t * chunkSize);
+        const int last = std::min(arraySize, first + chunkSize);
+        int* C = &local[t * buckets];
+        int* source = keys;
+        int* destination = scratch;
+
+        for (int p = 0; p < passes; p++) {
+            const int shift = p * digitBits;
+
+            // Count the digits of this chunk.
+            std::memset(C, 0, sizeof(int) * buckets);
+            for (int j = first; j < last; j++) {
+                C[RadixDigit(source[j], shift, mask)]++;
+            }
+            barrier.Wait();
+
+            // Merge into offsets: digit d of thread t starts after all smaller digits and after digit d of threads
+            // before t.
+            if (t == 0) {
+                int total = 0;
+                trivial = false;
+                for (int i = 0; i < buckets && !trivial; i++) {
+                    int digitTotal = 0;
+                    for (int u = 0; u < threadCount; u++) {
+                        int count = local[u * buckets + i];
+                        local[u * buckets + i] = total + digitTotal;
+                        digitTotal += count;
+                    }
+                    trivial = (digitTotal == arraySize);
+                    total += digitTotal;
+                }
+            }
+            barrier.Wait();
+            if (trivial) {
+                continue; // Every key shares this digit, the pass would leave the order unchanged.
+            }
+
+            // Scatter this chunk into the slots reserved for it, then wait for every chunk before reading them back.
+            if (combine) {
+                ScatterWriteCombined(source, destination, first, last, shift, mask, C,
+                    &staging[t * buckets * WRITE_COMBINE_KEYS], &fill[t * buckets]);
+            }
+            else {
+                for (int j = first; j < last; j++) {
+                    destination[C[RadixDigit(source[j], shift, mask)]++] = source[j];
+                }
+            }
+            barrier.Wait();
+
+            int* temp = source;
+            source = destination;
+            destination = temp;
+        }
+        return source;
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount - 1);
+    for (int t = 1; t < threadCount; t++) {
+        workers.emplace_back(SortChunk, t);
+    }
+    int* sorted = SortChunk(0); // Every thread ends on the same buffer.
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    if (sorted != keys) {
+        std::memcpy(keys, sorted, sizeof(int) * arraySize);
+    }
+    arena.Rewind(mark);
+}
+
+// Given:  keys         - The range of keys to be sorted.
+//         arraySize    - The number of elements in the range.
+//
+// Task:   To sort a short range of keys into ascending order by insertion.
+//
+// Return: keys         - The range of keys, now in sorted, ascending order.
+static void InsertionSortKeys(int* keys, const int arraySize) {
+    for (int j = 1; j < arraySize; j++) {
+        int key = keys[j];
+        int i = j - 1;
+        while (i >= 0 && keys[i] > key) {
+            keys[i + 1] = keys[i];
+            i--;
+        }
+        keys[i + 1] = key;
+    }
+}
+
+// Given:  keys         - The range of keys to be sorted, all of which share the digits above shift.
+//         arraySize    - The number of elements in the range.
+//         shift        - The bit position of the digit this level distributes on.
+//
+// Task:   To distribute the range into its 256 buckets in place, then sort each bucket on the next digit down.
+//
+// Return: keys         - The range of keys, now in sorted, ascending order.
+static void AmericanFlagSort(int* keys, const int arraySize, const int shift) {
+
+    if (arraySize < INSERTION_SORT_THRESHOLD) {
+        InsertionSortKeys(keys, arraySize);
+        return;
+    }
+
+    const int buckets = 256;
+    const unsigned int mask = 0xFF;
+    int C[buckets] = { 0 };
+    int head[buckets];
+    int tail[buckets];
+
+    for (int j = 0; j < arraySize; j++) {
+        C[RadixDigit(keys[j], shift, mask)]++;
+    }
+
+    // Every key shares this digit, move straight on to the next one.
+    if (C[RadixDigit(keys[0], shift, mask)] == arraySize) {
+        if (shift > 0) {
+            AmericanFlagSort(keys, arraySize, shift - 8);
+        }
+        return;
+    }
+
+    int total = 0;
+    for (int i = 0; i < buckets; i++) {
+        head[i] = total;
+        total += C[i];
+        tail[i] = total;
+    }
+
+    // Cycle every misplaced key into the next free slot of its bucket until each bucket holds only its own keys.
+    for (int i = 0; i < buckets; i++) {
+        while (head[i] < tail[i]) {
+            int key = keys[head[i]];
+            unsigned int digit = RadixDigit(key, shift, mask);
+            while (digit != static_cast<unsigned int>(i)) {
+                int displaced = keys[head[digit]];
+                keys[head[digit]++] = key;
+                key = displaced;
+                digit = RadixDigit(key, shift, mask);
+            }
+            keys[head[i]++] = key;
+        }
+    }
+
+    if (shift == 0) {
+        return;
+    }
+
+    int start = 0;
+    for (int i = 0; i < buckets; i++) {
+        if (C[i] > 1) {
+            AmericanFlagSort(&keys[start], C[i], shift - 8);
+        }
+        start += C[i];
+    }
+}
+
+void InPlaceRadixSortKeys(int* keys, const int arraySize) {
+
+    // American flag sort has a running time of O ( d n ) and needs only O ( d 2^b ) extra space for the counters,
+    // where d is the # of digits and b the width of a digit in bits.
+
+    if (arraySize < 2) {
+        return;
+    }
+    AmericanFlagSort(keys, arraySize, RADIX_KEY_BITS - 8);
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Arena.h"
+#include "globals.h"
+
+constexpr int RADIX_KEY_BITS = 32;       // Width of the keys handled by the radix engine.
+constexpr int RADIX_MAX_BITS = 11;       // Widest digit supported by the radix engine.
+constexpr int RADIX_MAX_PASSES = 4;      // Number of passes needed by the narrowest (8-bit) digit.
+constexpr int RADIX_MIN_BITS = (RADIX_KEY_BITS + RADIX_MAX_PASSES - 1) / RADIX_MAX_PASSES; // Narrowest digit supported.
+constexpr int INSERTION_SORT_THRESHOLD = 32;    // Buckets shorter than this are finished by insertion sort in the in-place mode.
+
+// Given:  key          - The integer key whose digit is wanted.
+//         shift        - The bit position of the digit's least significant bit.
+//         mask         - The mask selecting the digit once shifted, (1 << digitBits) - 1.
+//
+// Task:   To extract a digit from key. The sign bit is flipped so negative keys order before positive keys.
+//
+// Return: The digit of key at the given shift.
+inline unsigned int RadixDigit(const int key, const int shift, const unsigned int mask) {
+    return ((static_cast<unsigned int>(key) ^ 0x80000000u) >> shift) & mask;
+}
+
+// Given:  digitBits    - A requested digit width in bits.
+//
+// Task:   To bring the width within the digits the radix engine supports, so the histograms are never sized for more
+//         than 2^RADIX_MAX_BITS buckets nor the sort run for more than RADIX_MAX_PASSES passes.
+//
+// Return: digitBits clamped to RADIX_MIN_BITS .. RADIX_MAX_BITS.
+inline int SupportedDigitBits(const int digitBits) {
+    return (digitBits < RADIX_MIN_BITS) ? RADIX_MIN_BITS : (digitBits > RADIX_MAX_BITS) ? RADIX_MAX_BITS : digitBits;
+}
+
+// Given:  keys         - The array of keys to be counted.
+//         arraySize    - The number of elements in the keys array.
+//         digitBits    - The width of a digit in bits, 8 to 11; other widths are clamped by SupportedDigitBits.
+//         histograms   - An array of (passes * 2^digitBits) counters, zeroed by the caller.
+//         arena        - The arena the working copies of the histograms are taken from and returned to.
+//
+// Task:   To count the occurrences of every digit of every pass in a single read over keys.
+//
+// Return: histograms   - Histogram p occupying histograms[p * 2^digitBits] holds the counts for pass p.
+void BuildHistograms(const int* keys, const int arraySize, int digitBits, int* histograms, Arena& arena);
+
+// Given:  keys         - The array wished to be sorted.
+//         scratch      - A buffer of arraySize integers the passes ping-pong into, its contents are overwritten.
+//         arraySize    - The number of elements in the keys array.
+//         digitBits    - The width of a digit in bits, 8 to 11; other widths are clamped by SupportedDigitBits.
+//         arena        - The arena the histograms and staging buffers are taken from and returned to.
+//
+// Task:   To sort keys into ascending order with a least significant digit radix sort. All digit histograms are built
+//         up front, passes whose digit is the same for every key are skipped, and each pass scatters from one buffer
+//         into the other instead of copying back.
+//
+// Return: keys         - The array of keys, now in sorted, ascending order.
+void RadixSortKeys(int* keys, int* scratch, const int arraySize, int digitBits, Arena& arena);
+
+// Given:  keys         - The array wished to be sorted.
+//         scratch      - A buffer of arraySize integers the passes ping-pong into, its contents are overwritten.
+//         arraySize    - The number of elements in the keys array.
+//         digitBits    - The width of a digit in bits, 8 to 11; other widths are clamped by SupportedDigitBits.
+//         threadCount  - The number of threads to use, 0 selects the number of hardware threads.
+//         arena        - The arena the histograms and staging buffers are taken from and returned to.
+//
+// Task:   To sort keys into ascending order by splitting them into one chunk per thread. The threads are started
+//         once and meet at a barrier between the phases of every pass: each thread counts the digits of its own chunk,
+//         the local histograms are merged into per thread starting offsets, and every thread then scatters its chunk
+//         into its reserved slots. Arrays smaller than PARALLEL_SORT_THRESHOLD, or a single thread, fall back to
+//         RadixSortKeys.
+//
+// Return: keys         - The array of keys, now in sorted, ascending order.
+void ParallelRadixSortKeys(int* keys, int* scratch, const int arraySize, int digitBits, int threadCount, Arena& arena);
+
+// Given:  keys         - The array wished to be sorted.
+//         arraySize    - The number of elements in the keys array.
+//
+// Task:   To sort keys into ascending order without any scratch array using a most significant digit radix sort on
+//         8-bit digits (American flag sort). Each level counts the digits of a range, permutes the keys into their
+//         buckets by cycling swaps within the range, then recurses on every bucket with the next digit. Buckets shorter
+//         than INSERTION_SORT_THRESHOLD are finished with an insertion sort.
+//
+// Return: keys         - The array of keys, now in sorted, ascending order.
+void InPlaceRadixSortKeys(int* keys, const int arraySize);
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// Maps a key onto an unsigned integer of the same width whose ascending order matches the key's ascending order.
+// Unsigned integers map onto themselves, signed integers have their sign bit flipped, and IEEE floating point keys
+// flip every bit when negative and only the sign bit otherwise. bool has no unsigned counterpart and is left out.
+template <typename Key, typename Enable = void>
+struct RadixKeyTraits;
+
+template <typename Key>
+struct RadixKeyTraits<Key, typename std::enable_if<std::is_integral<Key>::value &&
+                                                   !std::is_same<Key, bool>::value>::type> {
+    using Bits = typename std::make_unsigned<Key>::type;
+
+    static Bits ToBits(const Key key) {
+        Bits bits = static_cast<Bits>(key);
+        if (std::is_signed<Key>::value) {
+            bits ^= static_cast<Bits>(Bits(1) << (sizeof(Key) * 8 - 1));
+        }
+        return bits;
+    }
+};
+
+template <typename Key>
+struct RadixKeyTraits<Key, typename std::enable_if<std::is_floating_point<Key>::value>::type> {
+    static_assert(sizeof(Key) == 4 || sizeof(Key) == 8, "Only 32 and 64 bit IEEE floating point keys are supported.");
+    using Bits = typename std::conditional<sizeof(Key) == 4, std::uint32_t, std::uint64_t>::type;
+
+    static Bits ToBits(const Key key) {
+        Bits bits;
+        std::memcpy(&bits, &key, sizeof(Key));
+        const Bits signBit = Bits(1) << (sizeof(Key) * 8 - 1);
+        return (bits & signBit) ? ~bits : (bits | signBit);
+    }
+};
+
+// Extracts the key of a bare key array, where every record is its own key.
+template <typename Key>
+struct IdentityKey {
+    Key operator()(const Key& record) const {
+        return record;
+    }
+};
+
+// Given:  records      - The array of records wished to be sorted.
+//         scratch      - A buffer of arraySize records the passes ping-pong into, its contents are overwritten.
+//         arraySize    - The number of elements in the records array.
+//         extractKey   - A callable returning the Key of a record.
+//
+// Task:   To stably sort the records into ascending order of their keys with a least significant digit radix sort on
+//         8-bit digits. The number of passes is the width of Key in bytes, fixed at compile time. Every histogram is
+//         built in one read, passes whose digit is shared by all keys are skipped, and records move together with
+//         their keys between the two buffers.
+//
+// Return: records      - The array of records, now in sorted, ascending order of their keys.
+template <typename Key, typename Value, typename KeyExtractor>
+void GenericRadixSort(Value* records, Value* scratch, const int arraySize, KeyExtractor extractKey) {
+
+    using Traits = RadixKeyTraits<Key>;
+    using Bits = typename Traits::Bits;
+    constexpr int passes = static_cast<int>(sizeof(Bits));
+    constexpr int buckets = 256;
+
+    if (arraySize < 2) {
+        return;
+    }
+
+    std::unique_ptr<int[]> histograms = std::make_unique<int[]>(passes * buckets);
+    for (int j = 0; j < arraySize; j++) {
+        Bits bits = Traits::ToBits(extractKey(records[j]));
+        for (int p = 0; p < passes; p++) {
+            histograms[p * buckets + static_cast<int>((bits >> (p * 8)) & 0xFF)]++;
+        }
+    }
+
+    Value* source = records;
+    Value* destination = scratch;
+
+    for (int p = 0; p < passes; p++) {
+        int* C = &histograms[p * buckets];
+        const int shift = p * 8;
+
+        if (C[(Traits::ToBits(extractKey(source[0])) >> shift) & 0xFF] == arraySize) {
+            continue; // Every key shares this digit, the pass would leave the order unchanged.
+        }
+
+        int total = 0;
+        for (int i = 0; i < buckets; i++) {
+            int count = C[i];
+            C[i] = total;
+            total += count;
+        }
+
+        for (int j = 0; j < arraySize; j++) {
+            int digit = static_cast<int>((Traits::ToBits(extractKey(source[j])) >> shift) & 0xFF);
+            destination[C[digit]++] = std::move(source[j]);
+        }
+
+        std::swap(source, destination);
+    }
+
+    if (source != records) {
+        for (int j = 0; j < arraySize; j++) {
+            records[j] = std::move(source[j]);
+        }
+    }
+}
+
+// Given:  keys         - The array of keys wished to be sorted.
+//         scratch      - A buffer of arraySize keys the passes ping-pong into, its contents are overwritten.
+//         arraySize    - The number of elements in the keys array.
+//
+// Task:   To sort a bare array of integer or floating point keys into ascending order.
+//
+// Return: keys         - The array of keys, now in sorted, ascending order.
+template <typename Key>
+void GenericRadixSort(Key* keys, Key* scratch, const int arraySize) {
+    GenericRadixSort<Key, Key>(keys, scratch, arraySize, IdentityKey<Key>());
+}
@@ -0,0 +1,305 @@
+#include "RobinHood.h"
+
+#include <algorithm>
+#include <utility>
+
+// Given:  Nothing.
+//
+// Task:   To initialize an empty table with room for a single key.
+//
+// Return: Nothing.
+RobinHoodTable::RobinHoodTable(void) {
+    Allocate(1);
+}
+
+// Given:  size   - The number of keys the table must hold.
+//
+// Task:   To initialize an empty table with enough slots to hold size keys at no more than 7/8 occupancy.
+//
+// Return: Nothing.
+RobinHoodTable::RobinHoodTable(const int size) {
+    Allocate(size);
+}
+
+// Given:  Nothing.
+//
+// Task:   To destroy the table and release any allocated memory.
+//
+// Return: Nothing.
+RobinHoodTable::~RobinHoodTable(void) {
+
+}
+
+// Given:  size   - The number of keys the table must hold.
+//
+// Task:   To allocate the smallest power of two number of slots keeping size keys at or below 7/8 occupancy, with
+//         at least one slot to spare so every insert finds a free slot.
+//
+// Return: Nothing.
+void RobinHoodTable::Allocate(const int size) {
+    const long long slotsNeeded = static_cast<long long>(size) * 8 / 7 + 1;
+    int bits = 0;
+    while ((1LL << bits) < slotsNeeded) {
+        bits++;
+    }
+
+    tableSize = 1 << bits;
+    mask = tableSize - 1;
+    shift = 32 - bits;
+    occupiedBuckets = 0;
+    maxDistance = 0;
+    headKey = 0;
+    tailKey = 0;
+
+    slots.reset(new RobinHoodSlot[tableSize]);
+    links.reset(new RobinHoodLinks[tableSize]); // Only read where the slot is occupied, so left uninitialized.
+    for (int slot = 0; slot < tableSize; slot++) {
+        slots[slot].distance = 0;
+    }
+}
+
+// Given:  Nothing.
+//
+// Task:   To simply return tableSize.
+//
+// Return: tableSize       - The number of slots in the table.
+int RobinHoodTable::GetTableSize(void) {
+    return tableSize;
+}
+
+// Given:  Nothing.
+//
+// Task:   To simply return occupiedBuckets.
+//
+// Return: occupiedBuckets        - The number of keys in the table.
+int RobinHoodTable::GetOccupiedBuckets(void) {
+    return occupiedBuckets;
+}
+
+// Given:  Nothing.
+//
+// Task:   To simply return maxDistance.
+//
+// Return: maxDistance     - The furthest from home any key has been placed. Erasing never lowers it, although the
+//                           keys left may all sit closer.
+int RobinHoodTable::GetMaxDistance(void) {
+    return maxDistance;
+}
+
+// Given:  key    - The key to be hashed.
+//
+// Task:   To pick the key's home slot by multiply-shift hashing, which needs no division.
+//
+// Return: The home slot of key.
+int RobinHoodTable::Home(const int key) {
+    const uint32_t hash = static_cast<uint32_t>(key) * 0x9E3779B9u;
+    return shift >= 32 ? 0 : static_cast<int>(hash >> shift);
+}
+
+// Given:  key                - The key to be found.
+//         searchAttempts     - An integer which currently contains dummy information.
+//
+// Task:   To probe from the key's home slot until the key, a free slot, or a key closer to its home than the probe has
+//         come from key's home. Keys are placed so that no key sits further from home than a key after it in the same
+//         run, so in the last two cases key is not in the table.
+//
+// Return: The slot holding key, or -1 when it is not present.
+//         searchAttempts (via reference)   - The number of slots probed.
+int RobinHoodTable::Find(const int key, int& searchAttempts) {
+    int slot = Home(key);
+    for (int distance = 1; ; distance++) {
+        searchAttempts = distance;
+        const RobinHoodSlot& probed = slots[slot];
+        if (probed.distance < distance) {
+            return -1; // A free slot (distance 0), or a key richer than key would be here.
+        }
+        if (probed.key == key) {
+            return slot;
+        }
+        slot = (slot + 1) & mask;
+    }
+}
+
+// Given:  key        - A key not in the table.
+//         keyLinks   - Its links in the ordered list.
+//
+// Task:   To place key from its home slot on. Whenever the key being carried is further from its home than the key in
+//         the slot reached is from its own, they swap: the carried key takes the slot and the one it displaced is
+//         carried on. The table must have a free slot.
+//
+// Return: The slot key was placed in.
+int RobinHoodTable::Place(const int key, const RobinHoodLinks& keyLinks) {
+    RobinHoodSlot carried = { key, 1 };
+    RobinHoodLinks carriedLinks = keyLinks;
+    int placedAt = -1;
+    for (int slot = Home(key); ; slot = (slot + 1) & mask, carried.distance++) {
+        RobinHoodSlot& resident = slots[slot];
+        if (carried.distance - 1 > maxDistance) {
+            maxDistance = carried.distance - 1;
+        }
+        if (resident.distance == 0) {
+            resident = carried;
+            links[slot] = carriedLinks;
+            return (placedAt < 0) ? slot : placedAt;
+        }
+        if (resident.distance < carried.distance) {
+            std::swap(resident, carried);
+            std::swap(links[slot], carriedLinks);
+            if (placedAt < 0) {
+                placedAt = slot;
+            }
+        }
+    }
+}
+
+// Given:  key            - The key to be added, larger than every key already in the table.
+//         prevBucket     - An integer which currently contains dummy information.
+//
+// Task:   To place key and link it after the largest key.
+//
+// Return: true or false                    - True indicating key was added, False indicating the table is full or key
+//                                            is not larger than every key in it.
+//         prevBucket (via reference)       - The slot key was placed in. Later inserts and erases may move it.
+bool RobinHoodTable::Append(const int key, int& prevBucket) {
+    const int capacity = tableSize - std::max(1, tableSize / 8);
+    if (occupiedBuckets >= capacity || (occupiedBuckets > 0 && key <= tailKey)) {
+        return false;
+    }
+    const RobinHoodLinks keyLinks = { tailKey, key };
+    if (occupiedBuckets > 0) {
+        int attempts;
+        links[Find(tailKey, attempts)].nextKey = key;
+    }
+    else {
+        headKey = key;
+    }
+    tailKey = key;
+    prevBucket = Place(key, keyLinks);
+    occupiedBuckets++;
+    return true;
+}
+
+// Given:  headNode            - A Struct of Node which is the first record to be added.
+//         prevBucket          - Integer representing the slot of the record inserted before headNode, here it is ignored.
+//
+// Task:   To insert the first record into the empty table, which starts the ordered list.
+//
+// Return: true or false                    - True indicating the record was added, False indicating the table is not empty.
+//         prevBucket (via reference)       - The slot the record was placed in.
+bool RobinHoodTable::SetHead(Node headNode, int& prevBucket) {
+    if (occupiedBuckets > 0) {
+        return false;
+    }
+    return Append(headNode.GetKey(), prevBucket);
+}
+
+// Given:  headNode            - A Struct of Node which is the next record to be added, larger than every key already in the table.
+//         prevBucket          - Integer representing the slot of the record inserted before headNode. Slots move as keys
+//                               are placed, so the list is extended from the largest key instead.
+//
+// Task:   To insert the record whilst retaining the order of the list.
+//
+// Return: true or false                    - True indicating the record was added, False indicating there is no room or
+//                                            the key is out of order.
+//         prevBucket (via reference)       - The slot the record was placed in.
+bool RobinHoodTable::HeadInsert(Node headNode, int& prevBucket) {
+    return Append(headNode.GetKey(), prevBucket);
+}
+
+// Given:  key    - The key to be erased.
+//
+// Task:   To unlink key from the ordered list and free its slot, shifting every following key of the run back one slot
+//         until a free slot or a key already at home. No tombstone is left, so later probes are no longer than if key
+//         had never been inserted.
+//
+// Return: true or false        - True indicating key was erased, False indicating it was not present.
+bool RobinHoodTable::Erase(const int key) {
+    int attempts;
+    int slot = Find(key, attempts);
+    if (slot < 0) {
+        return false;
+    }
+
+    const RobinHoodLinks keyLinks = links[slot];
+    if (key == headKey) {
+        headKey = keyLinks.nextKey;
+    }
+    else {
+        links[Find(keyLinks.prevKey, attempts)].nextKey = keyLinks.nextKey;
+    }
+    if (key == tailKey) {
+        tailKey = keyLinks.prevKey;
+    }
+    else {
+        links[Find(keyLinks.nextKey, attempts)].prevKey = keyLinks.prevKey;
+    }
+
+    for (int next = (slot + 1) & mask; slots[next].distance > 1; slot = next, next = (next + 1) & mask) {
+        slots[slot] = { slots[next].key, slots[next].distance - 1 };
+        links[slot] = links[next];
+    }
+    slots[slot].distance = 0;
+    occupiedBuckets--;
+    return true;
+}
+
+// Given:  searchKey          - An integer representing the key wished to be searched for.
+//         result             - A Struct of Node which contains dummy information.
+//         searchAttempts     - An integer which currently contains dummy information.
+//
+// Task:   To search for the slot holding searchKey.
+//
+// Return: true or false                    - True indicating the key was found, False indicating it was not.
+//         result (via reference)           - A Node holding the key and the slots probed from its home to reach it.
+//         searchAttempts (via reference)   - The number of slots probed.
+bool RobinHoodTable::Search(const int searchKey, Node& result, int& searchAttempts) {
+    const int slot = Find(searchKey, searchAttempts);
+    if (slot < 0) {
+        return false;
+    }
+    result.SetKeys(searchKey);
+    result.SetInitialAttempts(slots[slot].distance);
+    result.SetOccupancy(true);
+    return true;
+}
+
+// Given:  key    - An integer which currently contains dummy information.
+//
+// Task:   To find the smallest key.
+//
+// Return: true or false                - True indicating the table holds a key, False indicating it is empty.
+//         key (via reference)          - The smallest key.
+bool RobinHoodTable::GetFirst(int& key) {
+    key = headKey;
+    return occupiedBuckets > 0;
+}
+
+// Given:  key        - A key in the table.
+//         nextKey    - An integer which currently contains dummy information.
+//
+// Task:   To follow the ordered list one step from key.
+//
+// Return: true or false                - True indicating there is a larger key, False indicating key is the largest
+//                                        or is not in the table.
+//         nextKey (via reference)      - The next larger key.
+bool RobinHoodTable::GetNext(const int key, int& nextKey) {
+    int attempts;
+    const int slot = Find(key, attempts);
+    if (slot < 0 || key == tailKey) {
+        return false;
+    }
+    nextKey = links[slot].nextKey;
+    return true;
+}
+
+// Given:  Nothing.
+//
+// Task:   To print the keys in ascending order by following the ordered list from the smallest key.
+//
+// Return: Nothing.
+void RobinHoodTable::PrintList(void) {
+    int key;
+    for (bool more = GetFirst(key); more; more = GetNext(key, key)) {
+        std::cout << "Key: " << key << ", ModKey: " << key * 10 << std::endl;
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "globals.h"
+#include "node.h"
+
+#include <cstdint>
+
+// One slot of a RobinHoodTable, holding what a probe reads side by side so a probe step touches one cache line.
+struct RobinHoodSlot {
+    int key; // The stored key, valid when distance is above 0.
+    int distance; // 0 for a free slot, otherwise 1 + the distance of key from its home slot.
+};
+
+// The neighbours of a key in the ordered list of a RobinHoodTable. Links are keys rather than slots because keys move
+// between slots as others are inserted and erased.
+struct RobinHoodLinks {
+    int prevKey; // The next smaller key, valid unless this is the smallest key.
+    int nextKey; // The next larger key, valid unless this is the largest key.
+};
+
+// An open-addressing hash table with Robin Hood linear probing. Every slot records how far its key sits from its home
+// slot. An insert that reaches a key closer to home than itself takes that slot and carries the displaced key on, so
+// distances stay even across keys and the longest probe grows only with the logarithm of the table size. A search can
+// stop at the first slot whose key is closer to home than the search has come, since its key would have taken that
+// slot. Erase shifts the keys after the erased one back a slot instead of leaving a tombstone, so erasing never
+// lengthens later probes. The capacity is a power of two kept at no more than 7/8 occupancy.
+class RobinHoodTable {
+public:
+	RobinHoodTable();
+	RobinHoodTable(const int size);
+	~RobinHoodTable(void);
+	int GetTableSize(void);
+	int GetOccupiedBuckets(void);
+	int GetMaxDistance(void);
+	bool SetHead(Node headNode, int& prevBucket);
+	bool HeadInsert(Node headNode, int& prevBucket);
+	bool Erase(const int key);
+	bool Search(const int searchKey, Node& result, int& searchAttempts);
+	bool GetFirst(int& key);
+	bool GetNext(const int key, int& nextKey);
+	void PrintList(void);
+private:
+	void Allocate(const int size);
+	int Home(const int key);
+	int Find(const int key, int& searchAttempts);
+	int Place(const int key, const RobinHoodLinks& keyLinks);
+	bool Append(const int key, int& prevBucket);
+	int tableSize; // The number of slots, a power of two.
+	int mask; // tableSize - 1.
+	int shift; // 32 - log2(tableSize), so the top bits of a 32-bit hash select the home slot.
+	int occupiedBuckets; // The number of keys in the table.
+	int maxDistance; // The furthest from home any key has been placed.
+	int headKey; // The smallest key, valid while the table is not empty.
+	int tailKey; // The largest key, valid while the table is not empty.
+	std::unique_ptr<RobinHoodSlot[]> slots; // The key and distance of every slot, read by probes.
+	std::unique_ptr<RobinHoodLinks[]> links; // The ordered list links of the key of every occupied slot, moved with it.
+};
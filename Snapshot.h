@@ -0,0 +1,38 @@
+#pragma once
+
+#include "globals.h"
+
+#include <cstddef>
+#include <cstdint>
+
+constexpr char SNAPSHOT_MAGIC[8] = { 'R', 'D', 'X', 'H', 'A', 'S', 'H', '\0' };
+constexpr uint32_t SNAPSHOT_VERSION = 4;
+constexpr uint64_t SNAPSHOT_ALIGNMENT = 64; // Every section starts on a cache line, which also suits any element type.
+
+// Header of a HashTable snapshot. The sections follow at the recorded offsets, each an exact copy of the in-memory
+// array in the writer's native layout, so a reader maps the file and uses the arrays where they lie. Order links are
+// bucket indices, so nothing in the file depends on where it is mapped.
+struct SnapshotHeader {
+    char magic[8]; // SNAPSHOT_MAGIC, identifies the format.
+    uint32_t version; // SNAPSHOT_VERSION of the writer.
+    uint32_t nodeSize; // sizeof(Node) of the writer; a reader with another Node layout must rebuild instead.
+    int32_t tableSize; // The number of buckets.
+    int32_t orderCapacity; // The number of keys the ordered view can hold.
+    int32_t orderCount; // The number of keys in the ordered view.
+    int32_t occupiedBuckets; // The occupied bucket count of the table.
+    int32_t filterBlocks; // The number of Bloom filter blocks, 0 when the table has no filter.
+    int32_t hashPolicy; // The HashPolicy that placed every key; a table reopened from the file keeps using it.
+    uint64_t tableOffset; // Offset of the tableSize Nodes.
+    uint64_t probeKeysOffset; // Offset of the tableSize probe keys.
+    uint64_t orderKeysOffset; // Offset of the orderCapacity ordered keys.
+    uint64_t orderBucketsOffset; // Offset of the orderCapacity ordered buckets.
+    uint64_t sampleKeysOffset; // Offset of the sparse order index.
+    uint64_t bucketPositionsOffset; // Offset of the tableSize ordered view positions.
+    uint64_t filterOffset; // Offset of the Bloom filter blocks.
+    uint64_t statsOffset; // Offset of the insert probe and chain length HistogramCounts, so no scan rebuilds them.
+    uint64_t fileSize; // The length of the whole file.
+    uint32_t flags; // Always 0.
+    uint32_t checksum; // KeyFileChecksum of the header words before this field.
+};
+
+static_assert(sizeof(SnapshotHeader) % 8 == 0, "The snapshot header must hold a whole number of 32-bit words.");
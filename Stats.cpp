@@ -0,0 +1,389 @@
+#include "Stats.h"
+
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Given:  value    - A value to be counted.
+//
+// Task:   To find the bin a value is counted in.
+//
+// Return: The bin of the value.
+static int HistogramBin(const int value) {
+    if (value < 0) {
+        return 0;
+    }
+    return (value < STATS_HISTOGRAM_BINS - 1) ? value : STATS_HISTOGRAM_BINS - 1;
+}
+
+// Given:  Nothing.
+//
+// Task:   To initialize empty counts.
+//
+// Return: Nothing.
+HistogramCounts::HistogramCounts(void) {
+    std::memset(counts, 0, sizeof(counts));
+    sum = 0;
+    max = 0;
+}
+
+// Given:  value    - The value to be counted.
+//
+// Task:   To count one more value.
+//
+// Return: Nothing.
+void HistogramCounts::Record(const int value) {
+    counts[HistogramBin(value)]++;
+    sum += static_cast<uint64_t>(value);
+    if (value > max) {
+        max = value;
+    }
+}
+
+// Given:  from     - A value counted earlier.
+//         to       - The value it has become.
+//
+// Task:   To count the value as to instead of from. Counts are unsigned and wrap, so a thread may move values it
+//         never counted and the result is still right once merged into the Histogram that did count them.
+//
+// Return: Nothing.
+void HistogramCounts::Move(const int from, const int to) {
+    counts[HistogramBin(from)]--;
+    counts[HistogramBin(to)]++;
+    sum += static_cast<uint64_t>(to) - static_cast<uint64_t>(from);
+    if (to > max) {
+        max = to;
+    }
+}
+
+// Given:  Nothing.
+//
+// Task:   To initialize an empty histogram.
+//
+// Return: Nothing.
+Histogram::Histogram(void) {
+    Reset();
+}
+
+// Given:  value    - The value to be counted.
+//
+// Task:   To count one more value.
+//
+// Return: Nothing.
+void Histogram::Record(const int value) {
+    counts[HistogramBin(value)].fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(static_cast<uint64_t>(value), std::memory_order_relaxed);
+    RaiseMax(value);
+}
+
+// Given:  from     - A value counted earlier.
+//         to       - The value it has become.
+//
+// Task:   To count the value as to instead of from, e.g. when a bucket's chain grows by one.
+//
+// Return: Nothing.
+void Histogram::Move(const int from, const int to) {
+    const int fromBin = HistogramBin(from);
+    const int toBin = HistogramBin(to);
+    if (fromBin != toBin) {
+        counts[fromBin].fetch_sub(1, std::memory_order_relaxed);
+        counts[toBin].fetch_add(1, std::memory_order_relaxed);
+    }
+    sum.fetch_add(static_cast<uint64_t>(to) - static_cast<uint64_t>(from), std::memory_order_relaxed);
+    RaiseMax(to);
+}
+
+// Given:  local    - Counts gathered by one thread.
+//
+// Task:   To add the counts to the histogram.
+//
+// Return: Nothing.
+void Histogram::Merge(const HistogramCounts& local) {
+    for (int b = 0; b < STATS_HISTOGRAM_BINS; b++) {
+        if (local.counts[b] != 0) {
+            counts[b].fetch_add(local.counts[b], std::memory_order_relaxed);
+        }
+    }
+    sum.fetch_add(local.sum, std::memory_order_relaxed);
+    RaiseMax(local.max);
+}
+
+// Given:  Nothing.
+//
+// Task:   To forget every value counted.
+//
+// Return: Nothing.
+void Histogram::Reset(void) {
+    for (int b = 0; b < STATS_HISTOGRAM_BINS; b++) {
+        counts[b].store(0, std::memory_order_relaxed);
+    }
+    sum.store(0, std::memory_order_relaxed);
+    max.store(0, std::memory_order_relaxed);
+}
+
+// Given:  saved    - Counts read earlier with Read, e.g. from a snapshot.
+//
+// Task:   To replace the histogram's counts with the saved ones.
+//
+// Return: Nothing.
+void Histogram::Load(const HistogramCounts& saved) {
+    for (int b = 0; b < STATS_HISTOGRAM_BINS; b++) {
+        counts[b].store(saved.counts[b], std::memory_order_relaxed);
+    }
+    sum.store(saved.sum, std::memory_order_relaxed);
+    max.store(saved.max, std::memory_order_relaxed);
+}
+
+// Given:  Nothing.
+//
+// Task:   To copy the counts out, e.g. to save them.
+//
+// Return: The counts of the histogram.
+HistogramCounts Histogram::Read(void) {
+    HistogramCounts copy;
+    for (int b = 0; b < STATS_HISTOGRAM_BINS; b++) {
+        copy.counts[b] = counts[b].load(std::memory_order_relaxed);
+    }
+    copy.sum = sum.load(std::memory_order_relaxed);
+    copy.max = max.load(std::memory_order_relaxed);
+    return copy;
+}
+
+// Given:  bin      - A bin from 0 to STATS_HISTOGRAM_BINS - 1.
+//
+// Task:   To simply return the count of the bin.
+//
+// Return: The number of values equal to bin, or for the last bin, at least bin.
+uint64_t Histogram::GetCount(const int bin) {
+    return counts[bin].load(std::memory_order_relaxed);
+}
+
+// Given:  Nothing.
+//
+// Task:   To add up every bin.
+//
+// Return: The number of values counted.
+uint64_t Histogram::GetTotal(void) {
+    uint64_t total = 0;
+    for (int b = 0; b < STATS_HISTOGRAM_BINS; b++) {
+        total += counts[b].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+// Given:  Nothing.
+//
+// Task:   To simply return the largest value counted.
+//
+// Return: The largest value, 0 when nothing was counted.
+int Histogram::GetMax(void) {
+    return static_cast<int>(max.load(std::memory_order_relaxed));
+}
+
+// Given:  Nothing.
+//
+// Task:   To average the values counted.
+//
+// Return: The mean value, 0 when nothing was counted.
+double Histogram::GetMean(void) {
+    const uint64_t total = GetTotal();
+    return (total == 0) ? 0.0 : static_cast<double>(sum.load(std::memory_order_relaxed)) / total;
+}
+
+// Given:  value    - A value just counted.
+//
+// Task:   To raise max to value if it is larger. Values rarely beat the max, so this is usually a single load.
+//
+// Return: Nothing.
+void Histogram::RaiseMax(const int64_t value) {
+    int64_t current = max.load(std::memory_order_relaxed);
+    while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+// Given:  Nothing.
+//
+// Task:   To initialize counters that are not open yet.
+//
+// Return: Nothing.
+HardwareCounters::HardwareCounters(void) {
+    for (int e = 0; e < HW_EVENT_COUNT; e++) {
+        descriptors[e] = -1;
+    }
+}
+
+// Given:  Nothing.
+//
+// Task:   To close every open counter.
+//
+// Return: Nothing.
+HardwareCounters::~HardwareCounters(void) {
+#ifdef __linux__
+    for (int e = 0; e < HW_EVENT_COUNT; e++) {
+        if (descriptors[e] >= 0) {
+            close(descriptors[e]);
+        }
+    }
+#endif
+}
+
+// Given:  Nothing.
+//
+// Task:   To open and start a counter for every event the processor and the system allow. Each event gets a counter of
+//         its own rather than a group, so one unsupported event does not cost the others.
+//
+// Return: true or false        - True indicating at least one counter opened, False indicating none could.
+bool HardwareCounters::Open(void) {
+    bool opened = false;
+#ifdef __linux__
+    const uint32_t types[HW_EVENT_COUNT] = {
+        PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE
+    };
+    const uint64_t configs[HW_EVENT_COUNT] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES,
+        PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)
+    };
+    for (int e = 0; e < HW_EVENT_COUNT; e++) {
+        if (descriptors[e] >= 0) {
+            opened = true;
+            continue;
+        }
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = types[e];
+        attr.config = configs[e];
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.inherit = 1; // Count the sort and load threads too; they add to the count as they exit.
+        descriptors[e] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        opened = opened || descriptors[e] >= 0;
+    }
+#endif
+    return opened;
+}
+
+// Given:  event    - A HardwareEvent.
+//
+// Task:   To tell whether the event is being counted.
+//
+// Return: true or false        - True indicating the event's counter is open, False indicating it reads as zero.
+bool HardwareCounters::IsOpen(const int event) {
+    return descriptors[event] >= 0;
+}
+
+// Given:  values   - An array of HW_EVENT_COUNT counts which currently contains dummy information.
+//
+// Task:   To read every counter.
+//
+// Return: values (via reference)           - The count of every event so far, 0 for an event not counted.
+void HardwareCounters::Read(uint64_t* values) {
+    for (int e = 0; e < HW_EVENT_COUNT; e++) {
+        values[e] = 0;
+#ifdef __linux__
+        uint64_t value;
+        if (descriptors[e] >= 0 && read(descriptors[e], &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value))) {
+            values[e] = value;
+        }
+#endif
+    }
+}
+
+// Given:  event    - A HardwareEvent.
+//
+// Task:   To name the event for printing.
+//
+// Return: The name of the event.
+const char* HardwareCounters::GetEventName(const int event) {
+    static const char* const names[HW_EVENT_COUNT] = {
+        "cycles", "instructions", "cache misses", "branch misses", "dTLB load misses"
+    };
+    return names[event];
+}
+
+// Given:  Nothing.
+//
+// Task:   To initialize timers with nothing timed yet, opening the hardware counters when HARDWARE_COUNTERS is set.
+//
+// Return: Nothing.
+PhaseTimers::PhaseTimers(void) {
+    countersOpen = HARDWARE_COUNTERS && counters.Open();
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        seconds[p] = 0.0;
+        for (int e = 0; e < HW_EVENT_COUNT; e++) {
+            startEvents[p][e] = 0;
+            events[p][e] = 0;
+        }
+    }
+}
+
+// Given:  phase    - The BuildPhase starting.
+//
+// Task:   To note the time, and the event counts, at the start of the phase.
+//
+// Return: Nothing.
+void PhaseTimers::Start(const int phase) {
+    if (countersOpen) {
+        counters.Read(startEvents[phase]);
+    }
+    started[phase] = std::chrono::steady_clock::now();
+}
+
+// Given:  phase    - The BuildPhase ending, started earlier.
+//
+// Task:   To add the time, and the events, since the phase started to its totals.
+//
+// Return: Nothing.
+void PhaseTimers::Stop(const int phase) {
+    seconds[phase] += std::chrono::duration<double>(std::chrono::steady_clock::now() - started[phase]).count();
+    if (countersOpen) {
+        uint64_t now[HW_EVENT_COUNT];
+        counters.Read(now);
+        for (int e = 0; e < HW_EVENT_COUNT; e++) {
+            events[phase][e] += now[e] - startEvents[phase][e];
+        }
+    }
+}
+
+// Given:  phase    - A BuildPhase.
+//
+// Task:   To simply return the time spent in the phase.
+//
+// Return: The seconds spent in the phase, 0 when it never ran.
+double PhaseTimers::GetSeconds(const int phase) {
+    return seconds[phase];
+}
+
+// Given:  phase    - A BuildPhase.
+//         event    - A HardwareEvent.
+//
+// Task:   To simply return the events counted in the phase.
+//
+// Return: The number of events, 0 when the event is not counted.
+uint64_t PhaseTimers::GetEvents(const int phase, const int event) {
+    return countersOpen && counters.IsOpen(event) ? events[phase][event] : 0;
+}
+
+// Given:  Nothing.
+//
+// Task:   To tell whether hardware events are being counted.
+//
+// Return: true or false        - True indicating at least one counter is open, False indicating none are.
+bool PhaseTimers::HasHardwareCounters(void) {
+    return countersOpen;
+}
+
+// Given:  phase    - A BuildPhase.
+//
+// Task:   To name the phase for printing.
+//
+// Return: The name of the phase.
+const char* PhaseTimers::GetPhaseName(const int phase) {
+    static const char* const names[PHASE_COUNT] = { "read", "sort", "build", "snapshot" };
+    return names[phase];
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "globals.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+constexpr int STATS_HISTOGRAM_BINS = 32; // Values 0 .. 30 are counted one per bin, the last bin counts every larger one.
+
+// The events HardwareCounters can count.
+enum HardwareEvent {
+    HW_CYCLES,
+    HW_INSTRUCTIONS,
+    HW_CACHE_MISSES,
+    HW_BRANCH_MISSES,
+    HW_DTLB_MISSES,
+    HW_EVENT_COUNT
+};
+
+// The phases PhaseTimers can time.
+enum BuildPhase {
+    PHASE_READ, // Loading the keys, or with an external sort, reading and sorting them into runs.
+    PHASE_SORT, // Sorting the keys in memory.
+    PHASE_BUILD, // Inserting the keys, or with an external sort, merging the runs into the table.
+    PHASE_SNAPSHOT, // Reopening a snapshot instead of the three phases above.
+    PHASE_COUNT
+};
+
+// Plain counts of small values gathered by one thread, to be merged into a Histogram once it is done.
+struct HistogramCounts {
+    uint64_t counts[STATS_HISTOGRAM_BINS]; // counts[b] is the number of values b, the last bin of values b or more.
+    uint64_t sum; // The sum of every value, for the mean.
+    int64_t max; // The largest value.
+
+    HistogramCounts();
+    void Record(const int value);
+    void Move(const int from, const int to);
+};
+
+// Counts of small values, such as the buckets probed by an insert or a search. Values are recorded with relaxed
+// atomic adds, so any number of threads may record while another reads; a reader sees each count as of some recent
+// moment, not a consistent picture of all of them. Threads recording many values should gather them in a
+// HistogramCounts and Merge it, which costs one add per bin instead of one per value.
+class Histogram {
+public:
+	Histogram();
+	void Record(const int value);
+	void Move(const int from, const int to);
+	void Merge(const HistogramCounts& local);
+	void Reset(void);
+	void Load(const HistogramCounts& saved);
+	HistogramCounts Read(void);
+	uint64_t GetCount(const int bin);
+	uint64_t GetTotal(void);
+	int GetMax(void);
+	double GetMean(void);
+private:
+	void RaiseMax(const int64_t value);
+	alignas(64) std::atomic<uint64_t> counts[STATS_HISTOGRAM_BINS]; // On lines of its own, away from the table.
+	std::atomic<uint64_t> sum; // The sum of every value.
+	std::atomic<int64_t> max; // The largest value.
+};
+
+// Counters of hardware events for the calling thread and the threads it starts afterwards, read through
+// perf_event_open. Opening fails without Linux, or when perf_event_paranoid forbids it, in which case every count
+// reads as zero. Only user space events are counted, which is what an unprivileged process may count.
+class HardwareCounters {
+public:
+	HardwareCounters();
+	~HardwareCounters(void);
+	HardwareCounters(const HardwareCounters&) = delete;
+	HardwareCounters& operator=(const HardwareCounters&) = delete;
+	bool Open(void);
+	bool IsOpen(const int event);
+	void Read(uint64_t* values);
+	static const char* GetEventName(const int event);
+private:
+	int descriptors[HW_EVENT_COUNT]; // The counter of every event, -1 when it could not be opened.
+};
+
+// Wall clock time, and hardware events when HARDWARE_COUNTERS is set, spent in every BuildPhase. A phase may be timed
+// more than once, and its times add up.
+class PhaseTimers {
+public:
+	PhaseTimers();
+	void Start(const int phase);
+	void Stop(const int phase);
+	double GetSeconds(const int phase);
+	uint64_t GetEvents(const int phase, const int event);
+	bool HasHardwareCounters(void);
+	static const char* GetPhaseName(const int phase);
+private:
+	HardwareCounters counters; // Opened by the constructor when HARDWARE_COUNTERS is set.
+	bool countersOpen; // True when at least one counter opened.
+	std::chrono::steady_clock::time_point started[PHASE_COUNT]; // When every running phase started.
+	uint64_t startEvents[PHASE_COUNT][HW_EVENT_COUNT]; // The event counts when every running phase started.
+	double seconds[PHASE_COUNT]; // The time spent in every phase.
+	uint64_t events[PHASE_COUNT][HW_EVENT_COUNT]; // The events counted in every phase.
+};
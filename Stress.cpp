@@ -0,0 +1,132 @@
+// Thomas McLaughlin
+
+/*
+Summary:
+
+          A stress test of HashTable's concurrency contract: one writer thread inserts sorted keys with SetHead and
+          HeadInsert while several reader threads search, read the ordered view and run bound and range queries over
+          it. Every answer a reader gets is checked against what the writer could have published by then. Built with
+          -fsanitize=thread (the stress target, enabled with -DRADIXHASH_TSAN_STRESS=ON), it also reports any data race
+          between the writer and the readers.
+
+          Usage: stress [keys] [readers]
+
+          The program prints the number of failed checks and exits with 1 when there were any.
+
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "Hash.h"
+
+constexpr int STRESS_KEYS = 200000;     // Keys inserted by the writer when none are given.
+constexpr int STRESS_READERS = 3;       // Reader threads when none are given.
+constexpr int STRESS_RANGE = 8;         // Keys listed by every range query.
+
+
+// Given:  hashTable    - The table being filled by the writer.
+//         keyCount     - The number of keys the writer inserts; key p is 2p, so every odd key is absent.
+//         seed         - Seed of the reader's choice of positions.
+//         writerDone   - Set once the writer has inserted every key.
+//         failures     - The number of failed checks, shared by every reader.
+//
+// Task:   To query the table until the writer is done, and once more after, checking every answer: a published
+//         position holds its key, a published key is found by Search, LowerBound and UpperBound, an odd key is never
+//         found, and a range lists consecutive keys. The key the writer may be inserting at that moment is queried too,
+//         as it is the one a reader can catch half published.
+//
+// Return: failures (via reference)     - Increased by the number of failed checks.
+void ReadWhileWriting(HashTable& hashTable, const int keyCount, const unsigned seed, std::atomic<bool>& writerDone,
+                      std::atomic<int>& failures);
+
+
+int main(int argc, char** argv) {
+    const int keyCount = (argc > 1) ? std::max(1, std::atoi(argv[1])) : STRESS_KEYS;
+    const int readerCount = (argc > 2) ? std::max(1, std::atoi(argv[2])) : STRESS_READERS;
+
+    HashTable hashTable(keyCount);
+    std::atomic<bool> writerDone(false);
+    std::atomic<int> failures(0);
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < readerCount; r++) {
+        readers.emplace_back(ReadWhileWriting, std::ref(hashTable), keyCount, static_cast<unsigned>(r + 1),
+                             std::ref(writerDone), std::ref(failures));
+    }
+
+    Node record;
+    int prevBucket = -1;
+    for (int p = 0; p < keyCount; p++) {
+        record.SetKeys(2 * p);
+        if (!(p == 0 ? hashTable.SetHead(record, prevBucket) : hashTable.HeadInsert(record, prevBucket))) {
+            std::cout << "Key " << 2 * p << " Could Not Be Inserted" << std::endl;
+            failures++;
+            break;
+        }
+    }
+    writerDone.store(true, std::memory_order_release);
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+
+    std::cout << keyCount << " Keys, " << readerCount << " Readers: " << failures.load() << " Failed Checks"
+              << std::endl;
+    return (failures.load() == 0) ? 0 : 1;
+}
+
+
+void ReadWhileWriting(HashTable& hashTable, const int keyCount, const unsigned seed, std::atomic<bool>& writerDone,
+                      std::atomic<int>& failures) {
+    std::mt19937 generator(seed);
+    Node result;
+    int searchAttempts;
+    int buckets[STRESS_RANGE];
+
+    for (bool last = false; !last; ) {
+        last = writerDone.load(std::memory_order_acquire); // One full round runs after the writer finishes.
+        for (int round = 0; round < 256; round++) {
+            const int count = hashTable.GetOrderedCount();
+            if (count == 0) {
+                continue;
+            }
+            const int p = static_cast<int>(generator() % static_cast<unsigned>(count));
+            const int key = 2 * p;
+            int failed = 0;
+
+            failed += (hashTable.GetOrderedKey(p) != key);
+            failed += (hashTable.GetTable()[hashTable.GetOrderedBucket(p)].GetKey() != key);
+            failed += (!hashTable.Search(key, result, searchAttempts) || result.GetKey() != key);
+            failed += hashTable.Search(key + 1, result, searchAttempts);
+            failed += (hashTable.LowerBound(key) != p);
+            const int above = hashTable.UpperBound(key);
+            failed += (above != p + 1 && !(above == -1 && p + 1 == count)); // -1 only if p was last when read.
+
+            const int written = hashTable.RangeScan(key, key + 2 * (STRESS_RANGE - 1), buckets, STRESS_RANGE);
+            failed += (written < 1);
+            for (int i = 0; i < written; i++) {
+                failed += (hashTable.GetTable()[buckets[i]].GetKey() != key + 2 * i);
+            }
+            if (last) {
+                failed += (count != keyCount);
+            }
+
+            // Key 2 * count is either not published yet or complete; it may be in probeKeys before the ordered view.
+            if (count < keyCount) {
+                const int next = 2 * count;
+                failed += (hashTable.Search(next, result, searchAttempts) && result.GetKey() != next);
+                const int bound = hashTable.LowerBound(next);
+                failed += (bound != count && bound != -1);
+            }
+
+            if (failed > 0) {
+                failures += failed;
+            }
+        }
+    }
+}
@@ -0,0 +1,264 @@
+#include "SwissTable.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SWISS_SSE2 1
+#else
+#define SWISS_SSE2 0
+#endif
+
+// Given:  Nothing.
+//
+// Task:   To initialize an empty table of a single group.
+//
+// Return: Nothing.
+SwissTable::SwissTable(void) {
+    Allocate(1);
+}
+
+// Given:  size   - The number of keys the table must hold.
+//
+// Task:   To initialize an empty table with enough groups to hold size keys at no more than 7/8 occupancy.
+//
+// Return: Nothing.
+SwissTable::SwissTable(const int size) {
+    Allocate(size);
+}
+
+// Given:  Nothing.
+//
+// Task:   To destroy the table and release any allocated memory.
+//
+// Return: Nothing.
+SwissTable::~SwissTable(void) {
+
+}
+
+// Given:  size   - The number of keys the table must hold.
+//
+// Task:   To allocate the smallest power of two number of groups keeping size keys at or below 7/8 occupancy, which
+//         also guarantees every probe sequence reaches a free slot.
+//
+// Return: Nothing.
+void SwissTable::Allocate(const int size) {
+    long long slotsNeeded = static_cast<long long>(size) * 8 / 7 + 1;
+    int groups = 1;
+    while (static_cast<long long>(groups) * SWISS_GROUP_SIZE < slotsNeeded) {
+        groups *= 2;
+    }
+
+    tableSize = groups * SWISS_GROUP_SIZE;
+    groupMask = groups - 1;
+    headBucket = -1;
+    occupiedBuckets = 0;
+
+    control.reset(new signed char[tableSize]);
+    keys.reset(new int[tableSize]); // Only read where the control byte is a tag, so left uninitialized.
+    attempts.reset(new unsigned char[tableSize]);
+    nextSlot.reset(new int[tableSize]);
+    std::memset(control.get(), SWISS_EMPTY, tableSize);
+}
+
+// Given:  Nothing.
+//
+// Task:   To simply return headBucket.
+//
+// Return: headBucket       - The slot of the smallest key, -1 while the table is empty.
+int SwissTable::GetHead(void) {
+    return headBucket;
+}
+
+// Given:  Nothing.
+//
+// Task:   To simply return tableSize.
+//
+// Return: tableSize       - The number of slots in the table.
+int SwissTable::GetTableSize(void) {
+    return tableSize;
+}
+
+// Given:  Nothing.
+//
+// Task:   To simply return occupiedBuckets.
+//
+// Return: occupiedBuckets        - The number of slots that are occupied in the table.
+int SwissTable::GetOccupiedBuckets(void) {
+    return occupiedBuckets;
+}
+
+// Given:  key  - Integer representing the key to be hashed.
+//
+// Task:   To mix the key into 64 bits: the low 7 bits become the tag and the bits above select the first group.
+//
+// Return: The hash of the key.
+uint64_t SwissTable::Hash(const int key) {
+    uint64_t hash = static_cast<uint64_t>(static_cast<uint32_t>(key)) * 0x9E3779B97F4A7C15ull;
+    return hash ^ (hash >> 29);
+}
+
+// Given:  group    - The index of the group to examine.
+//         tag      - The 7-bit tag looked for.
+//
+// Task:   To compare the tag against all 16 control bytes of the group at once.
+//
+// Return: A bit mask with bit i set when slot i of the group holds tag.
+uint32_t SwissTable::MatchTag(const int group, const signed char tag) {
+    const signed char* bytes = &control[group * SWISS_GROUP_SIZE];
+#if SWISS_SSE2
+    __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(tag))));
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < SWISS_GROUP_SIZE; i++) {
+        mask |= static_cast<uint32_t>(bytes[i] == tag) << i;
+    }
+    return mask;
+#endif
+}
+
+// Given:  group    - The index of the group to examine.
+//
+// Task:   To find the free slots of the group. Only free slots have the top bit of their control byte set.
+//
+// Return: A bit mask with bit i set when slot i of the group is free.
+uint32_t SwissTable::MatchEmpty(const int group) {
+    const signed char* bytes = &control[group * SWISS_GROUP_SIZE];
+#if SWISS_SSE2
+    __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+    return static_cast<uint32_t>(_mm_movemask_epi8(ctrl));
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < SWISS_GROUP_SIZE; i++) {
+        mask |= static_cast<uint32_t>(bytes[i] < 0) << i;
+    }
+    return mask;
+#endif
+}
+
+// Given:  mask     - A non-zero bit mask.
+//
+// Task:   To find the lowest set bit of mask.
+//
+// Return: The index of the lowest set bit.
+static inline int LowestBit(const uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(mask);
+#else
+    int index = 0;
+    while (((mask >> index) & 1u) == 0) {
+        index++;
+    }
+    return index;
+#endif
+}
+
+// Given:  key              - The key to be placed.
+//         groupsProbed     - An integer which currently contains dummy information.
+//
+// Task:   To claim the first free slot on the key's probe sequence, visiting groups in triangular order.
+//
+// Return: The claimed slot.
+//         groupsProbed (via reference)     - The number of groups visited.
+int SwissTable::Claim(const int key, int& groupsProbed) {
+    uint64_t hash = Hash(key);
+    int group = static_cast<int>((hash >> 7) & static_cast<uint64_t>(groupMask));
+    groupsProbed = 1;
+    for (int step = 1; ; step++) {
+        uint32_t empty = MatchEmpty(group);
+        if (empty != 0) {
+            int slot = group * SWISS_GROUP_SIZE + LowestBit(empty);
+            control[slot] = static_cast<signed char>(hash & 0x7F);
+            keys[slot] = key;
+            attempts[slot] = static_cast<unsigned char>(std::min(groupsProbed, 255));
+            nextSlot[slot] = -1;
+            occupiedBuckets++;
+            return slot;
+        }
+        group = (group + step) & groupMask; // Triangular steps visit every group of a power of two table.
+        groupsProbed++;
+    }
+}
+
+// Given:  headNode            - A Struct of Node which is the first, smallest, record to be added.
+//         prevBucket          - Integer which currently contains dummy information.
+//
+// Task:   To insert the first record into the table and make it the head of the ordered list.
+//
+// Return: true or false                    - True indicating there is room to insert, False indicating the table is full.
+//         prevBucket (via reference)       - The slot that was just filled, to set up the next insert.
+bool SwissTable::SetHead(Node headNode, int& prevBucket) {
+    if (occupiedBuckets >= tableSize - tableSize / 8) {
+        return false;
+    }
+    int groupsProbed;
+    headBucket = Claim(headNode.GetKey(), groupsProbed);
+    prevBucket = headBucket;
+    return true;
+}
+
+// Given:  headNode            - A Struct of Node which is the next record to be added.
+//         prevBucket          - Integer representing the slot of the record inserted before headNode.
+//
+// Task:   To insert the record and link it after prevBucket so the ordered list is retained.
+//
+// Return: true or false                    - True indicating there is room to insert, False indicating the table is full.
+//         prevBucket (via reference)       - The slot that was just filled, to set up the next insert.
+bool SwissTable::HeadInsert(Node headNode, int& prevBucket) {
+    if (occupiedBuckets >= tableSize - tableSize / 8) {
+        return false;
+    }
+    int groupsProbed;
+    int slot = Claim(headNode.GetKey(), groupsProbed);
+    nextSlot[prevBucket] = slot;
+    prevBucket = slot;
+    return true;
+}
+
+// Given:  searchKey          - An integer representing the key wished to be searched for.
+//         result             - A Struct of Node which contains dummy information.
+//         searchAttempts     - An integer which currently contains dummy information.
+//
+// Task:   To search for searchKey one group at a time: slots whose tag matches are compared against the key, and a
+//         group with a free slot ends an unsuccessful search.
+//
+// Return: true or false                    - True indicating the search value was found, False indicating it was not.
+//         result (via reference)           - A Struct of Node holding the key and its insert attempts.
+//         searchAttempts (via reference)   - The number of groups probed.
+bool SwissTable::Search(const int searchKey, Node& result, int& searchAttempts) {
+    uint64_t hash = Hash(searchKey);
+    const signed char tag = static_cast<signed char>(hash & 0x7F);
+    int group = static_cast<int>((hash >> 7) & static_cast<uint64_t>(groupMask));
+    searchAttempts = 0;
+
+    for (int step = 1; step <= groupMask + 1; step++) {
+        searchAttempts++;
+        for (uint32_t match = MatchTag(group, tag); match != 0; match &= match - 1) {
+            int slot = group * SWISS_GROUP_SIZE + LowestBit(match);
+            if (keys[slot] == searchKey) {
+                result.SetKeys(searchKey);
+                result.SetInitialAttempts(attempts[slot]);
+                result.SetOccupancy(true);
+                return true;
+            }
+        }
+        if (MatchEmpty(group) != 0) {
+            return false;
+        }
+        group = (group + step) & groupMask;
+    }
+    return false;
+}
+
+// Given:  Nothing.
+//
+// Task:   To print the retained sorted list in ascending order by starting from headBucket.
+//
+// Return: Nothing.
+void SwissTable::PrintList(void) {
+    for (int slot = headBucket; slot != -1; slot = nextSlot[slot]) {
+        std::cout << "Key: " << keys[slot] << ", ModKey: " << keys[slot] * 10 << std::endl;
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "globals.h"
+#include "node.h"
+
+#include <cstdint>
+
+constexpr int SWISS_GROUP_SIZE = 16;            // Slots whose control bytes are matched with one SIMD compare.
+constexpr signed char SWISS_EMPTY = -128;       // Control byte of a free slot; occupied slots hold a 7-bit tag instead.
+
+// An open-addressing hash table in the Swiss table style. Every slot has a control byte holding 7 bits of the key's
+// hash, and a probe compares the control bytes of a whole group of 16 slots at once, so only slots whose tag matches
+// are ever read. The capacity is a power of two, so no division is needed to pick a group.
+class SwissTable {
+public:
+	SwissTable();
+	SwissTable(const int size);
+	~SwissTable(void);
+	int GetHead(void);
+	int GetTableSize(void);
+	int GetOccupiedBuckets(void);
+	bool SetHead(Node headNode, int& prevBucket);
+	bool HeadInsert(Node headNode, int& prevBucket);
+	bool Search(const int searchKey, Node& result, int& searchAttempts);
+	void PrintList(void);
+private:
+	void Allocate(const int size);
+	uint64_t Hash(const int key);
+	uint32_t MatchTag(const int group, const signed char tag);
+	uint32_t MatchEmpty(const int group);
+	int Claim(const int key, int& groupsProbed);
+	int tableSize; // The number of slots, a multiple of SWISS_GROUP_SIZE and a power of two.
+	int groupMask; // The number of groups minus one.
+	int headBucket; // The slot of the smallest key, -1 while the table is empty.
+	int occupiedBuckets; // The number of slots in use.
+	std::unique_ptr<signed char[]> control; // One control byte per slot.
+	std::unique_ptr<int[]> keys; // The key of every occupied slot.
+	std::unique_ptr<unsigned char[]> attempts; // The number of groups probed to insert the key of every slot.
+	std::unique_ptr<int[]> nextSlot; // The slot holding the next larger key, -1 after the largest.
+};
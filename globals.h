@@ -1,13 +1,22 @@
 #pragma once
 
-#include <cmath>
 #include <iostream>
 #include <fstream>
 #include <memory>
 
 
 // CHANGE TO DESIRE BELOW ---
-constexpr int MAX_DIGITS = 5;   // Number of places in the form: xx,xxx.
-constexpr int RANGE = 99999;     // 9999 to adhere to 4 place digits, 99999 to adhere to 5 place digits, and so on.
+constexpr const char* KEY_FILE = "keys.txt";    // Key file to load: text with one key per line, or the binary key format.
+constexpr const char* SORTED_KEY_FILE = "";     // When not empty, the sorted keys are also written here in the binary key format.
+constexpr int RADIX_DIGIT_BITS = 11;    // Width of a radix digit in bits: 8 sorts in four passes, 11 sorts in three.
+constexpr int SORT_THREADS = 0;         // Threads used by the radix sort: 0 uses every hardware thread, 1 keeps the sort serial.
+constexpr int PARALLEL_SORT_THRESHOLD = 1 << 16;   // Arrays with fewer keys than this are always sorted serially.
+constexpr int EXTERNAL_SORT_KEYS = 0;   // When above 0, the key file is sorted externally, holding at most this many keys in memory.
+constexpr bool SORT_IN_PLACE = false;   // true sorts within the key array (American flag sort) for hosts short on memory.
+constexpr int HASH_POLICY = 1;          // How HashTable hashes keys: 0 multiply-shift, the cheapest, 1 a murmur finalizer, which also spreads keys sharing long runs of bits.
+constexpr int LOOKUP_FILTER_BITS = 12;  // Bits per key of the Bloom filter checked before probing for a key, 0 for no filter.
+constexpr const char* SNAPSHOT_FILE = "";       // When not empty, the built table is saved here and later runs reopen it instead of rebuilding.
+constexpr int ARENA_HUGE_PAGES = 1;     // Huge pages behind the sort buffers and the table: 0 none, 1 transparent, 2 explicit with transparent as fallback.
+constexpr bool COLLECT_SEARCH_STATS = false;    // true counts the buckets probed by every search, for the statistics; each Search then updates counters shared by every reader thread.
+constexpr bool HARDWARE_COUNTERS = false;       // true also counts cycles, cache and TLB misses per build phase through perf_event_open.
 // CHANGE TO DESIRE ABOVE ---
-const int MAX_PLACE = static_cast<int>(pow(10, (MAX_DIGITS - 1)));  // Smallest power of 10 that has the number of digits specified by MAX_DIGITS. For 5 place digits: 10^(4).
@@ -12,7 +12,8 @@ Summary:
           (2) Print the list of occupied buckets in order
           (3) Search a key
           (4) Statistics/Monitoring
-          (5) Quit
+          (5) List the keys in a range
+          (6) Quit
 
           
          Afterwards, the program frees up all memory space that was dynamically allocated. The goal is to search fast and to sort fast. With the below
@@ -23,118 +24,100 @@ Summary:
 
 
 
+#include "ExternalSort.h"
 #include "Hash.h"
+#include "KeyFile.h"
+#include "Loader.h"
+#include "Radix.h"
 
 
 
-// Given:  arraySize    - The size of the array to be allocated.
+// Given:  inFile       - The mapped key file, text or binary.
+//         arena        - The arena to allocate the parsed keys from.
+//         Numbers      - A pointer which currently contains dummy information.
+//         keys         - A pointer which currently contains dummy information.
+//         sorted       - A boolean which currently contains dummy information.
 // 
-// Task:   To dynamically allocate an array of Node structs of size arraySize using a smart pointer.
+// Task:   To load the keys of the mapped file. Text files are parsed into a Numbers array taken from arena, while the
+//         keys of a valid binary key file are used where they lie in the mapping without being copied.
 // 
-// Return: A std::unique_ptr to an array of Node structs of size arraySize.
-std::unique_ptr<Node[]> AllocateArrayNode(const int arraySize);
+// Return: The number of keys loaded, or -1 when a binary key file fails validation.
+//         Numbers (via reference)      - The parsed keys for a text file, otherwise nullptr.
+//         keys (via reference)         - A pointer to the first key, either into Numbers or into the mapping.
+//         sorted (via reference)       - True when the binary key file is flagged as already sorted.
+int LoadKeys(MappedFile& inFile, Arena& arena, int*& Numbers, int*& keys, bool& sorted);
 
 
-// Given:  arraySize    - The size of the array to be allocated.
-// 
-// Task:   To dynamically allocate an array of integers structs of size arraySize using a smart pointer.
-// 
-// Return: A std::unique_ptr to an array of integers of size arraySize.
-std::unique_ptr<int[]> AllocateArrayInt(const int arraySize);
-
-
-// Given:  Numbers      - An array of Node structs.
+// Given:  Numbers      - An array of unsorted integers.
 //         arraySize    - The number of elements in the Numbers array.
-//         inFile       - A reference to the input file stream.
-// 
-// Task:   To read in the unsorted integer numbers from the input file and store them in the Numbers array.
-// 
-// Return: Numbers      - An array of Node structs populated with data read from file.
-void ReadData(std::unique_ptr<Node[]>& Numbers, const int arraySize, std::ifstream& inFile);
-
-
-// Given:  inFile       - A reference to the input file stream.
-//         maxDigits    - Number of places in the form: xx,xxx yields 5.
+//         digitBits    - The width of a radix digit in bits, 8 or 11.
+//         arena        - The arena to take the scratch array and histograms from, rewound before returning.
 // 
-// Task:   To determine the number of integers/records in the input file by calculating the file size
-//         and dividing it by the number of bytes per line (assuming 5-character integers and newline characters).
-//         The function calculates the number of integers/records based on the size of the file and returns it.
+// Task:   To sort the integers in the Numbers array into ascending order using the binary radix engine, which
+//         ping-pongs between Numbers and a single scratch array of equal length. Large arrays are sorted with
+//         SORT_THREADS threads. When SORT_IN_PLACE is set the keys are permuted within Numbers and no scratch is used.
 // 
-// Return: An integer representing the number of records/integers in the file.
-int ReadSize(std::ifstream& inFile, const int maxDigits);
-
-// Given:  Numbers      - The array wished to be sorted.
-//         B            - A temporary array to store the sorted numbers based upon the current digit place.
-//         digitPlace   - The place we wish to evaluate: unit place, tens place, hundreds place, etc.
-// 
-// Task:   To sort the Numbers array into ascending order based on the digit indicated by the parameter digitPlace.
-// 
-// Return: B            - Containing the data from numbers which is sorted into ascending order by the digitPlace.
-void CountingSort(std::unique_ptr<Node[]>& Numbers, std::unique_ptr<int[]>& B, const int digitPlace, const int arraySize, const int range);
+// Return: Numbers      - An array of integers, now in sorted, ascending order.
+void RadixSort(int* Numbers, const int arraySize, const int digitBits, Arena& arena);
 
 
-// Given:  Numbers      - An array of unsorted integers.
-//         maxPlace     - Integer which is the smallest power of 10 that has the number of digits specified by MAX_DIGITS.
+// Given:  hashTable    - The hash table being built.
+//         keys         - The next batch of keys in ascending order.
+//         count        - The number of elements in the keys array.
+//         prevBucket   - Integer representing the bucket of the last key inserted, -1 before the first key.
 // 
-// Task:   To sort the integers in the Numbers array into ascending order using Radix Sort (with CountingSort as its stable sort).
+// Task:   To insert a batch of sorted keys into the hash table, making the very first key the head of the list.
+//         Copies of the sentinel are skipped, as BulkLoad skips them.
 // 
-// Return: Numbers      - An array of integers, now in sorted, ascending order.
-void RadixSort(std::unique_ptr<Node[]>& Numbers, const int maxPlace, const int arraySize, const int range);
+// Return: true or false                    - True indicating every key but the sentinel was inserted, False indicating
+//                                            the table ran out of room.
+//         prevBucket (via reference)       - The bucket of the last key inserted.
+bool InsertSortedKeys(HashTable& hashTable, const int* keys, const int count, int& prevBucket);
 
 
-// Given:  valueInQuestion      - An integer representing the value we want to check for occurrences for throughout the table.
-//         table                - A hash table containing all Node data.
+// Given:  hashTable    - The hash table to be built, which currently contains dummy information.
+//         arena        - The arena to take the table and every sort buffer from, which must outlive the table.
 // 
-// Task:   To tally up occurrences where valueQuestion equals the number of times this bucket was hashed to on the first attempt.
+// Task:   To load the keys of KEY_FILE, sort them and insert them into the hash table, writing SORTED_KEY_FILE on the way
+//         when one is wanted. The pages of the sort buffers are handed back before returning, leaving the table's.
+//         Exits the program when the keys cannot be loaded.
 // 
-// Return: result               - The total number of times where valueQuestion equaled the number of times this bucket was hashed to on the first attempt.
-int CalculateCapacityChain(const int valueInQuestion, HashTable& table);
+// Return: hashTable (via reference)        - The hash table holding every key.
+void BuildHashTable(HashTable& hashTable, Arena& arena);
 
 
 int main(void) {
     
     Node result;
     int searchKey;
+    int rangeHigh;
     int searchAttempts;
     bool menu = true;
     int userChoice;
-    int popularBucket;
-    int openAddressResult;
 
-    std::ifstream inFile;
-    inFile.open("keys.txt");  // Open File
-    if (inFile.fail()) {
-        std::cout << "File Failed To Open" << std::endl;
-        exit(1);
+    Arena arena; // Declared first so it outlives the hash table built in it.
+    HashTable hashTable;
+    bool reopened = false;
+    if (SNAPSHOT_FILE[0] != '\0') {
+        hashTable.GetPhaseTimers().Start(PHASE_SNAPSHOT);
+        reopened = hashTable.LoadSnapshot(SNAPSHOT_FILE);
+        hashTable.GetPhaseTimers().Stop(PHASE_SNAPSHOT);
     }
-
-    int arraySize = ReadSize(inFile, MAX_DIGITS);
-
-    std::unique_ptr<Node[]> Numbers = AllocateArrayNode(arraySize);
-
-    ReadData(Numbers, arraySize, inFile);
-
-    inFile.close(); // Close File
-
-    RadixSort(Numbers, MAX_PLACE, arraySize, RANGE); // Sort the Numbers array in ascending order.
-
-    HashTable hashTable(arraySize);
-    int prevBucket = 0;
-    hashTable.SetHead(Numbers[0], prevBucket);
-
-    for (int i = 1; i < arraySize; i++) {
-        hashTable.HeadInsert(Numbers[i], prevBucket);
+    if (!reopened) {
+        BuildHashTable(hashTable, arena); // No usable snapshot, so load, sort and insert the keys.
+        if (SNAPSHOT_FILE[0] != '\0' && !hashTable.SaveSnapshot(SNAPSHOT_FILE)) {
+            std::cout << "Snapshot Failed To Write" << std::endl;
+        }
     }
 
-    Numbers.reset(); // Deallocate the array and set it equal to Nullptr as we do not need it anymore.
-
     while (menu) {
         std::cout << "Select an operation:" << std::endl;
         std::cout << "\t(1) Print the entire Hash Table" << std::endl;
         std::cout << "\t(2) Print the list of occupied buckets in order" << std::endl;
         std::cout << "\t(3) Search a key" << std::endl;
         std::cout << "\t(4) Statistics" << std::endl;
-        std::cout << "\t(5) Quit" << std::endl;
+        std::cout << "\t(5) List the keys in a range" << std::endl;
+        std::cout << "\t(6) Quit" << std::endl;
         std::cin >> userChoice;
 
         switch (userChoice) {
@@ -174,32 +157,25 @@ int main(void) {
         case 4:
             std::cout << std::endl;
             std::cout << "- - - - - - - - - - - - - - - - - - - - - - -" << std::endl;
-            std::cout << "Number of occupied buckets: " << hashTable.GetOccupiedBuckets() << std::endl;
-            std::cout << "Number of unoccupied buckets: " << hashTable.GetTableSize() << std::endl;
-            std::cout << "\t" << hashTable.GetOccupiedBuckets() << " out of the " << hashTable.GetTableSize() << " buckets contains relevant data." << std::endl;
-            // chain
-            std::cout << std::endl << "Monitoring of Chaining (I did not go with this implementation): " << std::endl;
-            popularBucket = hashTable.PopularBucketChain();
-            std::cout << "\tLongest List of items if chaining was used: " << popularBucket << std::endl;
-            std::cout << std::endl << "\tNumber of buckets with 1 or more items if chaining was used: " << hashTable.CalculateOnePlusBuckets() << std::endl<< std::endl;
-
-            for (int i = 0; i <= popularBucket; i++) {
-                std::cout << "\tNumber of buckets with " << i << " items: " << CalculateCapacityChain(i, hashTable) << std::endl;
-            }
-            //chain
-            //open ad
-            std::cout << std::endl << "Monitoring of Open Addressing (I went with this implementation): " << std::endl;
-            popularBucket = 1;
-            std::cout << "\tLongest List of items with Open Addressing: "<< popularBucket<< std::endl;
-            std::cout << std::endl << "\tNumber of buckets with 1 or more items with Open Addressing: " << hashTable.GetOccupiedBuckets() << std::endl << std::endl;
-
-            std::cout << "\tNumber of buckets with 0 items: " << hashTable.GetTableSize() - hashTable.GetOccupiedBuckets() << std::endl;
-            std::cout << "\tNumber of buckets with 1 items: " << hashTable.GetOccupiedBuckets() << std::endl;
-
+            hashTable.DumpStats(std::cout);
             std::cout << "- - - - - - - - - - - - - - - - - - - - - - -" << std::endl;
             std::cout << std::endl;
             break;
         case 5:
+            std::cout << std::endl;
+            std::cout << "- - - - - - - - - - - - - - - - - - - - - - -" << std::endl;
+            std::cout << "Enter the smallest and largest key of the range:" << std::endl;
+            std::cin >> searchKey >> rangeHigh;
+            for (int position = hashTable.LowerBound(searchKey); position != -1 && position < hashTable.GetOrderedCount(); position++) {
+                if (hashTable.GetOrderedKey(position) > rangeHigh) {
+                    break;
+                }
+                std::cout << "Key: " << hashTable.GetOrderedKey(position) << ", Bucket: " << hashTable.GetOrderedBucket(position) << std::endl;
+            }
+            std::cout << "- - - - - - - - - - - - - - - - - - - - - - -" << std::endl;
+            std::cout << std::endl;
+            break;
+        case 6:
             menu = false;
             break;
         default:
@@ -216,141 +192,152 @@ int main(void) {
 }
 
 
-void ReadData(std::unique_ptr<Node[]>& Numbers, const int arraySize, std::ifstream& inFile) {
-    int fileValue;
-    for (int i = 0; i < arraySize; i++) {
-        inFile >> fileValue;
-        Numbers[i].SetKeys(fileValue);
-    }
-}
-
-int ReadSize(std::ifstream& inFile, const int maxDigits) {
+void BuildHashTable(HashTable& hashTable, Arena& arena) {
 
-    inFile.seekg(0l, std::ios::end);        // Seek to end.
-    int itemSize = sizeof(char) * (maxDigits + 2);        // This is for 5 characters, followed by carriage return, line feed.
-    // Those 2 characters mark the end of a line of text in Windows.
-    int fileSize = ((int)inFile.tellg()) / itemSize;  // Divide by 7 to get number of characters in the file.
-    inFile.seekg(0l, std::ios::beg); // Seek back to beginning.
-
-    return (fileSize + 1); // returning (fileSize + 1) as fileSize is one less than the number of records.
-}
-
-std::unique_ptr<Node[]> AllocateArrayNode(const int arraySize) {
-    // Smart pointers make our lives easier. Smart pointers automate the managing of our pointers, and in general are safer than raw pointers.
-    // By using smart pointers, I do not have to worry about deallocating the memory as it is automatically deallocated and cleaned up when it goes out of scope.
+    MappedFile inFile;
+    if (!inFile.Open(KEY_FILE)) {  // Map the whole file into memory.
+        std::cout << "File Failed To Open" << std::endl;
+        exit(1);
+    }
 
+    int* Numbers = nullptr;
+    int* keys = nullptr;
+    bool sorted = false;
+    int arraySize;
+    ExternalSorter sorter(EXTERNAL_SORT_KEYS, arena);
 
-    try {
-        return std::make_unique<Node[]>(arraySize); // Allocate memory for Numbers dynamically (on the heap) | Auto deletes when out of scope.
+    PhaseTimers& phases = hashTable.GetPhaseTimers();
+    phases.Start(PHASE_READ);
+    if (EXTERNAL_SORT_KEYS > 0) {
+        arraySize = sorter.CreateRuns(inFile); // Sort the file in bounded chunks spilled to temporary runs.
     }
-    catch (const std::bad_alloc& e) {
-        // Handle failures.
-        std::cerr << "Memory allocation failed: " << e.what() << std::endl;
-        return nullptr;
+    else {
+        arraySize = LoadKeys(inFile, arena, Numbers, keys, sorted);
     }
-}
-
-std::unique_ptr<int[]> AllocateArrayInt(const int arraySize) {
-    // Smart pointers make our lives easier. Smart pointers automate the managing of our pointers, and in general are safer than raw pointers.
-    // By using smart pointers, I do not have to worry about deallocating the memory as it is automatically deallocated and cleaned up when it goes out of scope.
+    phases.Stop(PHASE_READ);
 
-
-    try {
-        return std::make_unique<int[]>(arraySize); // Allocate memory for Numbers dynamically (on the heap) | Auto deletes when out of scope.
+    if (arraySize < 0) {
+        std::cout << "Key File Could Not Be Sorted" << std::endl;
+        exit(1);
     }
-    catch (const std::bad_alloc& e) {
-        // Handle failures.
-        std::cerr << "Memory allocation failed: " << e.what() << std::endl;
-        return nullptr;
+    if (arraySize == 0) {
+        std::cout << "File Contains No Keys" << std::endl;
+        exit(1);
     }
-}
 
-void CountingSort(std::unique_ptr<Node[]>& Numbers, std::unique_ptr<int[]>& B, const int digitPlace, const int arraySize, const int range) {
-
-    // Counting Sort has a worst case time of theta ( k + n ).
-    // Counting Sort has an average case time of theta ( k + n ).
-    // Where k is the # of values.
-
-    //      COUNTING-SORT(A, n, k)
-    // 1         let B[1:n] and C[0:k] be new arrays   | I instead initialized all of C's elements to 0 w/o a loop, and passed in array B.
-    // 2         for i = 0 to k
-    // 3             C[i] = 0
-    // 4         for j = 1 to n
-    // 5             C[A[j]] = C[A[j]] + 1
-    // 6         // C[i] now contains the number of elements equal to i.
-    // 7         for i = 1 to k
-    // 8             C[i] = C[i] + C[i - 1]
-    // 9         // C[i] now contains the number of elements less than or equal to i.
-    // 10        // Copy A to B, starting from the end of A.
-    // 11        for j = n down to 1
-    // 12            B[C[A[j]]] = A[j]
-    // 13            C[A[j]] = C[A[j]] - 1
-    // 14        return B                              | B[] was passed in by reference as a parameter, we 'return' B this way.
-
-
-    std::unique_ptr<int[]> C = AllocateArrayInt(range); // Declaring a smart pointer, unique_ptr, to manage the dynamic array.
-
-    // range acts as K: if max number goes up to 7, the range is 8 (0-7).
-    for (int i = 0; i < range; i++) {
-        C[i] = 0;
+    hashTable.Allocate(arraySize, arena);
+    int prevBucket = -1;
+
+    if (EXTERNAL_SORT_KEYS > 0) {
+        // Merge the runs straight into the hash table, and into the sorted key file when one is wanted.
+        phases.Start(PHASE_BUILD);
+        KeyFileWriter sortedFile;
+        bool writeSorted = SORTED_KEY_FILE[0] != '\0' && sortedFile.Open(SORTED_KEY_FILE);
+        bool inserted = true;
+        bool merged = sorter.MergeRuns([&](const int* batch, const int count) {
+            inserted = inserted && InsertSortedKeys(hashTable, batch, count, prevBucket);
+            if (writeSorted) {
+                sortedFile.Write(batch, count);
+            }
+        });
+        phases.Stop(PHASE_BUILD);
+        if (!merged) {
+            std::cout << "Key File Could Not Be Sorted" << std::endl;
+            exit(1);
+        }
+        if (!inserted) {
+            std::cout << "Hash Table Could Not Be Built" << std::endl;
+            exit(1);
+        }
+        if (SORTED_KEY_FILE[0] != '\0' && !(writeSorted && sortedFile.Close(true))) {
+            std::cout << "Sorted Key File Failed To Write" << std::endl;
+        }
+        sorter.DiscardRuns();
     }
+    else {
+        if (!sorted) {
+            phases.Start(PHASE_SORT);
+            RadixSort(keys, arraySize, RADIX_DIGIT_BITS, arena); // Sort the keys in ascending order.
+            phases.Stop(PHASE_SORT);
+        }
 
-    int digit;
+        if (SORTED_KEY_FILE[0] != '\0' && !WriteKeyFile(SORTED_KEY_FILE, keys, arraySize, true)) {
+            std::cout << "Sorted Key File Failed To Write" << std::endl;
+        }
 
-    // Count the occurrences.
-    for (int j = 0; j < arraySize; j++) {
-        digit = (Numbers[j].GetKey() / digitPlace) % range; // Get the digit at the current place value.
-        C[digit] = C[digit] + 1;
-        // C[i] now contains the number of elements equal to i.
+        phases.Start(PHASE_BUILD);
+        if (!hashTable.BulkLoad(keys, arraySize, SORT_THREADS)) { // Every key is in memory, so load them all at once.
+            std::cout << "Hash Table Could Not Be Built" << std::endl;
+            exit(1);
+        }
+        phases.Stop(PHASE_BUILD);
     }
 
-    // Sum up elements across array.
-    for (int i = 1; i < range; i++) {
-        C[i] = C[i] + C[i - 1];
+    // Both paths skip the sentinel key rather than fail, so say how many keys that left out.
+    const int skipped = arraySize - hashTable.GetOrderedCount();
+    if (skipped > 0) {
+        std::cout << skipped << " Key(s) Skipped: " << EMPTY_BUCKET << " Marks An Empty Bucket" << std::endl;
     }
 
-    // Copy numbers to array B, starting from the end of the Numbers array.
-    for (int j = arraySize - 1; j >= 0; j--) {
-        digit = (Numbers[j].GetKey() / digitPlace) % range; // Get the digit at the current place value.
-        B[C[digit] - 1] = Numbers[j].GetKey(); // Put the element in its proper location in B based on the digit.
-        C[digit] = C[digit] - 1; // Decrement the count so we can handle duplicates.
+    if (Numbers != nullptr) {
+        arena.Release(Numbers, sizeof(int) * arraySize); // Hand the pages back as we do not need the keys anymore.
     }
+    inFile.Close(); // Unmap the file, the keys may have been sorted in place inside it.
+}
+
+int LoadKeys(MappedFile& inFile, Arena& arena, int*& Numbers, int*& keys, bool& sorted) {
 
+    if (IsBinaryKeyFile(inFile.GetData(), inFile.GetSize())) {
+        KeyFileHeader header;
+        if (!ReadKeyFileHeader(inFile.GetData(), inFile.GetSize(), header)) {
+            return -1;
+        }
+        // The keys are sorted where they lie; the mapping is copy-on-write so the file itself is left untouched.
+        keys = reinterpret_cast<int*>(inFile.GetWritableData() + sizeof(KeyFileHeader));
+        sorted = (header.flags & KEY_FILE_SORTED) != 0;
+        return static_cast<int>(header.count);
+    }
+
+    int arraySize = CountRecords(inFile.GetData(), inFile.GetSize());
+    Numbers = arena.Allocate<int>(arraySize);
+    keys = Numbers;
+    sorted = false;
+    return ParseKeys(inFile.GetData(), inFile.GetSize(), keys, arraySize);
 }
 
-void RadixSort(std::unique_ptr<Node[]>& Numbers, const int maxPlace, const int arraySize, const int range) {
+void RadixSort(int* Numbers, const int arraySize, const int digitBits, Arena& arena) {
 
     // Radix Sort has a worst case time of theta ( d (n + k) ).
     // Radix Sort has an average case time of theta ( d (n + k) ).
-    // Where k is the # of values, d is the # of digits, and n is the length of the array.
+    // Where k is the # of values a digit can take, d is the # of digits, and n is the length of the array.
 
     //      RADIX-SORT(A, n, d)
     // 1         for i = 1 to d
     // 2             use a stable sort to sort array A[1:n] on digit i
 
-    std::unique_ptr<int[]> B = AllocateArrayInt(arraySize); // Declaring a smart pointer, unique_ptr, to manage the dynamic array.
-
-
-    // Iterate over each digit place
-    for (int digitPlace = 1; digitPlace <= maxPlace; digitPlace *= 10) {
+    if (SORT_IN_PLACE) {
+        InPlaceRadixSortKeys(Numbers, arraySize);
+        return;
+    }
 
-        CountingSort(Numbers, B, digitPlace, arraySize, range); // CountingSort will sort based on the provided digit place.
+    const ArenaMark mark = arena.Mark();
+    int* B = arena.Allocate<int>(arraySize); // Scratch array the passes alternate with, allocated once.
 
-        // Now copying B to Numbers array. Note that this wastes some time, O(n) time, where n is the length of the array.
-        for (int k = 0; k < arraySize; k++) {
-            Numbers[k].SetKeys(B[k]);
-        }
-    }
+    ParallelRadixSortKeys(Numbers, B, arraySize, digitBits, SORT_THREADS, arena);
+    arena.Rewind(mark);
 }
 
-int CalculateCapacityChain(const int valueInQuestion, HashTable& table) {
-
-    int result = 0;
-    std::unique_ptr<Node[]>& tempTable = table.GetTable();
-    for (int i = 0; i < table.GetTableSize(); i++) {
-        if (tempTable[i].GetGeneralBuckets() == valueInQuestion) {
-            result++; // Tallying up occurrences where valueQuestion equals the number of times this bucket was hashed to on the first attempt.
+bool InsertSortedKeys(HashTable& hashTable, const int* keys, const int count, int& prevBucket) {
+    Node record;
+    for (int i = 0; i < count; i++) {
+        if (keys[i] == EMPTY_BUCKET) {
+            continue; // The sentinel cannot be stored; main reports how many were skipped.
+        }
+        record.SetKeys(keys[i]);
+        const bool inserted = (prevBucket < 0) ? hashTable.SetHead(record, prevBucket) : hashTable.HeadInsert(record, prevBucket);
+        if (!inserted) {
+            return false;
         }
     }
-    return result;
+    return true;
 }
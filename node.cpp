@@ -9,7 +9,6 @@ Node::Node(void) {
     key = 0;
     modKey = 0;
     attemptsInitialInsert = 0;
-    next = nullptr;
     occupancy = false;
     generalAttempts = 0;
 }
@@ -33,15 +32,6 @@ void Node::SetKeys(const int nKey) {
     modKey = key * 10;
 }
 
-// Given:  nextNode     - A pointer to the nextNode.
-// 
-// Task:   To set next equal to nextNode.
-// 
-// Return: Nothing.
-void Node::SetNext(Node* nextNode) {
-    next = nextNode;
-}
-
 // Given:  Nothing.
 // 
 // Task:   To simply return key.
@@ -60,15 +50,6 @@ int Node::GetModKey(void) {
     return modKey;
 }
 
-// Given:  Nothing.
-// 
-// Task:   To simply return next.
-// 
-// Return: next     - Node pointer which points to the next Node or to nullptr.
-Node* Node::GetNext(void) {
-    return next;
-}
-
 // Given:  nOccupancy     - Boolean representing the updated occupancy of the given Node.
 // 
 // Task:   To set occupancy equal to nOccupancy.